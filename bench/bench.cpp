@@ -0,0 +1,782 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018 - 2026 Daniil Goncharov <neargye@gmail.com>.
+//
+// Permission is hereby  granted, free of charge, to any  person obtaining a copy
+// of this software and associated  documentation files (the "Software"), to deal
+// in the Software  without restriction, including without  limitation the rights
+// to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+// copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+// IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+// FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+// AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+// LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Self-contained micro benchmarks for scope_guard.
+// Usage: scope_guard-bench [--benchmark_filter=<substring>] [--benchmark_min_time=<seconds>]
+//                          [--benchmark_repetitions=<n>] [--benchmark_out=<file.json>]
+// Without --benchmark_out the results are printed to stdout as JSON, with it a table is printed instead.
+// The JSON layout follows Google Benchmark, so its compare.py can diff two runs.
+
+#include <scope_guard.hpp>
+#include <scope_guard_epoch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#  include <intrin.h>
+#  define BENCH_NOINLINE __declspec(noinline)
+#else
+#  define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace {
+
+// do_not_optimize forces the value to be materialized in memory and treated as read and written.
+template <typename T>
+inline void do_not_optimize(T& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  static_cast<void>(*static_cast<volatile char*>(static_cast<void*>(&value)));
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "r"(&value) : "memory");
+#endif
+}
+
+// Touch is the action body used by every benchmark: cheap, but not removable.
+inline void touch(int& counter) {
+  ++counter;
+  do_not_optimize(counter);
+}
+
+// Baselines.
+
+struct raii_guard {
+  int& counter;
+  ~raii_guard() {
+    touch(counter);
+  }
+};
+
+struct function_guard {
+  std::function<void()> action;
+  bool execute;
+
+  explicit function_guard(std::function<void()> a) : action{std::move(a)}, execute{true} {}
+  function_guard(const function_guard&) = delete;
+  function_guard& operator=(const function_guard&) = delete;
+
+  void dismiss() {
+    execute = false;
+  }
+
+  ~function_guard() {
+    if (execute) {
+      action();
+    }
+  }
+};
+
+void baseline_empty_loop(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    touch(counter);
+  }
+}
+
+void baseline_raii_struct(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    raii_guard g{counter};
+    do_not_optimize(g);
+  }
+}
+
+void baseline_std_function(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    function_guard g{[&]() { touch(counter); }};
+  }
+}
+
+void baseline_std_function_dismiss(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    function_guard g{[&]() { touch(counter); }};
+    g.dismiss();
+    do_not_optimize(g);
+  }
+}
+
+void baseline_try_catch(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    try {
+      do_not_optimize(counter);
+    } catch (...) {
+      touch(counter);
+      throw;
+    }
+  }
+}
+
+// scope_exit.
+
+void scope_exit_make(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    auto g = scope_guard::make_scope_exit([&]() { touch(counter); });
+    do_not_optimize(g);
+  }
+}
+
+void scope_exit_dismiss(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    auto g = scope_guard::make_scope_exit([&]() { touch(counter); });
+    g.dismiss();
+    do_not_optimize(g);
+  }
+}
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+void scope_exit_make_pinned(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    auto g = scope_guard::make_pinned_scope_exit([&]() { touch(counter); });
+    do_not_optimize(g);
+  }
+}
+#endif
+
+void scope_exit_macro(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    SCOPE_EXIT{ touch(counter); };
+  }
+}
+
+void scope_exit_with_macro(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    WITH_SCOPE_EXIT({ touch(counter); }) {
+      do_not_optimize(counter);
+    }
+  }
+}
+
+// scope_fail, success path.
+
+void scope_fail_make(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    auto g = scope_guard::make_scope_fail([&]() { touch(counter); });
+    do_not_optimize(g);
+  }
+}
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+void scope_fail_make_pinned(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    auto g = scope_guard::make_pinned_scope_fail([&]() { touch(counter); });
+    do_not_optimize(g);
+  }
+}
+#endif
+
+void scope_fail_macro(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    SCOPE_FAIL{ touch(counter); };
+    do_not_optimize(counter);
+  }
+}
+
+void scope_fail_macro_x5(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    SCOPE_FAIL{ touch(counter); };
+    SCOPE_FAIL{ touch(counter); };
+    SCOPE_FAIL{ touch(counter); };
+    SCOPE_FAIL{ touch(counter); };
+    SCOPE_FAIL{ touch(counter); };
+    do_not_optimize(counter);
+  }
+}
+
+void scope_fail_region_x5(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    scope_guard::scope_fail_region region;
+    SCOPE_FAIL_IN(region){ touch(counter); };
+    SCOPE_FAIL_IN(region){ touch(counter); };
+    SCOPE_FAIL_IN(region){ touch(counter); };
+    SCOPE_FAIL_IN(region){ touch(counter); };
+    SCOPE_FAIL_IN(region){ touch(counter); };
+    do_not_optimize(counter);
+  }
+}
+
+void scope_fail_group_x5(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    auto g = scope_guard::make_scope_fail([&]() { touch(counter); }, [&]() { touch(counter); }, [&]() { touch(counter); }, [&]() { touch(counter); }, [&]() { touch(counter); });
+    do_not_optimize(counter);
+  }
+}
+
+void rollback_dismiss_x5(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    MAKE_SCOPE_EXIT(g1){ touch(counter); };
+    MAKE_SCOPE_EXIT(g2){ touch(counter); };
+    MAKE_SCOPE_EXIT(g3){ touch(counter); };
+    MAKE_SCOPE_EXIT(g4){ touch(counter); };
+    MAKE_SCOPE_EXIT(g5){ touch(counter); };
+    do_not_optimize(counter);
+    g1.dismiss();
+    g2.dismiss();
+    g3.dismiss();
+    g4.dismiss();
+    g5.dismiss();
+    do_not_optimize(g1);
+    do_not_optimize(g2);
+    do_not_optimize(g3);
+    do_not_optimize(g4);
+    do_not_optimize(g5);
+  }
+}
+
+void rollback_transaction_commit_x5(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    scope_guard::scope_transaction transaction;
+    SCOPE_ROLLBACK(transaction){ touch(counter); };
+    SCOPE_ROLLBACK(transaction){ touch(counter); };
+    SCOPE_ROLLBACK(transaction){ touch(counter); };
+    SCOPE_ROLLBACK(transaction){ touch(counter); };
+    SCOPE_ROLLBACK(transaction){ touch(counter); };
+    do_not_optimize(counter);
+    transaction.commit();
+    do_not_optimize(transaction);
+  }
+}
+
+void scope_fail_on_status(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    bool ok = false;
+    SCOPE_FAIL_ON(ok){ touch(counter); };
+    do_not_optimize(counter);
+    ok = true;
+  }
+}
+
+// scope_success, success path.
+
+void scope_success_make(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    auto g = scope_guard::make_scope_success([&]() { touch(counter); });
+    do_not_optimize(g);
+  }
+}
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+void scope_success_make_pinned(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    auto g = scope_guard::make_pinned_scope_success([&]() { touch(counter); });
+    do_not_optimize(g);
+  }
+}
+#endif
+
+void scope_success_macro(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    SCOPE_SUCCESS{ touch(counter); };
+  }
+}
+
+// Type-erased guard.
+
+void any_scope_exit_make(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    scope_guard::any_scope_exit<> g{[&]() { touch(counter); }};
+    do_not_optimize(g);
+  }
+}
+
+void any_scope_exit_move_assign(std::size_t n) {
+  int counter = 0;
+  scope_guard::any_scope_exit<> member;
+  for (std::size_t i = 0; i < n; ++i) {
+    member = scope_guard::any_scope_exit<>{[&]() { touch(counter); }};
+    do_not_optimize(member);
+  }
+}
+
+// Runtime number of cleanups: 16 actions per scope.
+
+void cleanups_std_function_vector_16(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    std::vector<std::function<void()>> cleanups;
+    for (int j = 0; j < 16; ++j) {
+      cleanups.emplace_back([&counter, j]() { counter += j; });
+    }
+    for (auto it = cleanups.rbegin(); it != cleanups.rend(); ++it) {
+      (*it)();
+    }
+  }
+  do_not_optimize(counter);
+}
+
+void cleanups_scope_exit_stack_16(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    scope_guard::scope_exit_stack<> cleanups;
+    for (int j = 0; j < 16; ++j) {
+      cleanups.push([&counter, j]() { counter += j; });
+    }
+  }
+  do_not_optimize(counter);
+}
+
+void cleanups_scope_exit_stack_spill_64(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    scope_guard::scope_exit_stack<> cleanups;
+    for (int j = 0; j < 64; ++j) {
+      cleanups.push([&counter, j]() { counter += j; });
+    }
+  }
+  do_not_optimize(counter);
+}
+
+// Exception baseline capture.
+
+void uncaught_exceptions_detail(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    counter += scope_guard::detail::uncaught_exceptions();
+    do_not_optimize(counter);
+  }
+}
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+void uncaught_exceptions_std(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    counter += std::uncaught_exceptions();
+    do_not_optimize(counter);
+  }
+}
+#endif
+
+// Epoch-based reclamation: read-side critical sections against a mutex, retiring against deleting in place.
+
+void epoch_mutex_read(std::size_t n) {
+  int counter = 0;
+  std::mutex mutex;
+  for (std::size_t i = 0; i < n; ++i) {
+    std::lock_guard<std::mutex> lock{mutex};
+    touch(counter);
+  }
+}
+
+void epoch_guard_read(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    scope_guard::epoch_guard guard;
+    touch(counter);
+  }
+}
+
+void epoch_new_delete(std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    int* object = new int{0};
+    do_not_optimize(*object);
+    delete object;
+  }
+}
+
+void epoch_defer_retire(std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    int* object = new int{0};
+    do_not_optimize(*object);
+    scope_guard::defer_retire(object);
+  }
+  scope_guard::epoch_synchronize();
+}
+
+// Read-mostly cache: two background readers, the measured thread reads and replaces the value every 64th iteration.
+void epoch_read_mostly_2_readers(std::size_t n) {
+  std::atomic<int*> shared{new int{0}};
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 2; ++r) {
+    readers.emplace_back([&shared, &stop]() {
+      int counter = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        scope_guard::epoch_guard guard;
+        counter += *shared.load(std::memory_order_acquire);
+        do_not_optimize(counter);
+      }
+    });
+  }
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    scope_guard::epoch_guard guard;
+    if (i % 64 == 0) {
+      scope_guard::defer_retire(shared.exchange(new int{static_cast<int>(i)}, std::memory_order_acq_rel));
+    } else {
+      counter += *shared.load(std::memory_order_acquire);
+      do_not_optimize(counter);
+    }
+  }
+  stop = true;
+  for (std::thread& t : readers) {
+    t.join();
+  }
+  scope_guard::defer_retire(shared.load());
+  scope_guard::epoch_synchronize();
+}
+
+// Unwinding through N guards.
+
+BENCH_NOINLINE void throw_plain(int& counter) {
+  do_not_optimize(counter);
+  throw 1;
+}
+
+BENCH_NOINLINE void throw_through_scope_fail_1(int& counter) {
+  SCOPE_FAIL{ touch(counter); };
+  throw_plain(counter);
+}
+
+BENCH_NOINLINE void throw_through_scope_fail_8(int& counter) {
+  SCOPE_FAIL{ touch(counter); };
+  SCOPE_FAIL{ touch(counter); };
+  SCOPE_FAIL{ touch(counter); };
+  SCOPE_FAIL{ touch(counter); };
+  SCOPE_FAIL{ touch(counter); };
+  SCOPE_FAIL{ touch(counter); };
+  SCOPE_FAIL{ touch(counter); };
+  SCOPE_FAIL{ touch(counter); };
+  throw_plain(counter);
+}
+
+BENCH_NOINLINE void throw_through_scope_exit_8(int& counter) {
+  SCOPE_EXIT{ touch(counter); };
+  SCOPE_EXIT{ touch(counter); };
+  SCOPE_EXIT{ touch(counter); };
+  SCOPE_EXIT{ touch(counter); };
+  SCOPE_EXIT{ touch(counter); };
+  SCOPE_EXIT{ touch(counter); };
+  SCOPE_EXIT{ touch(counter); };
+  SCOPE_EXIT{ touch(counter); };
+  throw_plain(counter);
+}
+
+BENCH_NOINLINE void throw_through_try_catch_1(int& counter) {
+  try {
+    throw_plain(counter);
+  } catch (...) {
+    touch(counter);
+    throw;
+  }
+}
+
+BENCH_NOINLINE void throw_through_try_catch_8(int& counter) {
+  try {
+    throw_plain(counter);
+  } catch (...) {
+    touch(counter);
+    touch(counter);
+    touch(counter);
+    touch(counter);
+    touch(counter);
+    touch(counter);
+    touch(counter);
+    touch(counter);
+    throw;
+  }
+}
+
+BENCH_NOINLINE void throw_through_std_function_8(int& counter) {
+  function_guard g1{[&]() { touch(counter); }};
+  function_guard g2{[&]() { touch(counter); }};
+  function_guard g3{[&]() { touch(counter); }};
+  function_guard g4{[&]() { touch(counter); }};
+  function_guard g5{[&]() { touch(counter); }};
+  function_guard g6{[&]() { touch(counter); }};
+  function_guard g7{[&]() { touch(counter); }};
+  function_guard g8{[&]() { touch(counter); }};
+  throw_plain(counter);
+}
+
+template <void (*F)(int&)>
+void unwind(std::size_t n) {
+  int counter = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    try {
+      F(counter);
+    } catch (int) {
+      do_not_optimize(counter);
+    }
+  }
+}
+
+struct benchmark {
+  const char* name;
+  void (*run)(std::size_t);
+};
+
+const benchmark benchmarks[] = {
+    {"baseline/empty_loop", &baseline_empty_loop},
+    {"baseline/raii_struct", &baseline_raii_struct},
+    {"baseline/std_function", &baseline_std_function},
+    {"baseline/std_function_dismiss", &baseline_std_function_dismiss},
+    {"baseline/try_catch", &baseline_try_catch},
+    {"scope_exit/make_scope_exit", &scope_exit_make},
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    {"scope_exit/make_pinned_scope_exit", &scope_exit_make_pinned},
+#endif
+    {"scope_exit/dismiss", &scope_exit_dismiss},
+    {"scope_exit/SCOPE_EXIT", &scope_exit_macro},
+    {"scope_exit/WITH_SCOPE_EXIT", &scope_exit_with_macro},
+    {"scope_fail/make_scope_fail", &scope_fail_make},
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    {"scope_fail/make_pinned_scope_fail", &scope_fail_make_pinned},
+#endif
+    {"scope_fail/SCOPE_FAIL", &scope_fail_macro},
+    {"scope_fail/SCOPE_FAIL_x5", &scope_fail_macro_x5},
+    {"scope_fail/SCOPE_FAIL_IN_region_x5", &scope_fail_region_x5},
+    {"scope_fail/make_scope_fail_group_x5", &scope_fail_group_x5},
+    {"rollback/dismiss_x5", &rollback_dismiss_x5},
+    {"rollback/scope_transaction_commit_x5", &rollback_transaction_commit_x5},
+    {"scope_fail/SCOPE_FAIL_ON", &scope_fail_on_status},
+    {"scope_success/make_scope_success", &scope_success_make},
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    {"scope_success/make_pinned_scope_success", &scope_success_make_pinned},
+#endif
+    {"scope_success/SCOPE_SUCCESS", &scope_success_macro},
+    {"any_scope/any_scope_exit", &any_scope_exit_make},
+    {"any_scope/move_assign", &any_scope_exit_move_assign},
+    {"cleanups/std_function_vector/16", &cleanups_std_function_vector_16},
+    {"cleanups/scope_exit_stack/16", &cleanups_scope_exit_stack_16},
+    {"cleanups/scope_exit_stack_spill/64", &cleanups_scope_exit_stack_spill_64},
+    {"uncaught_exceptions/detail", &uncaught_exceptions_detail},
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    {"uncaught_exceptions/std", &uncaught_exceptions_std},
+#endif
+    {"epoch/mutex_read", &epoch_mutex_read},
+    {"epoch/epoch_guard", &epoch_guard_read},
+    {"epoch/new_delete", &epoch_new_delete},
+    {"epoch/defer_retire", &epoch_defer_retire},
+    {"epoch/read_mostly_2_readers", &epoch_read_mostly_2_readers},
+    {"unwind/plain", &unwind<&throw_plain>},
+    {"unwind/scope_fail/1", &unwind<&throw_through_scope_fail_1>},
+    {"unwind/scope_fail/8", &unwind<&throw_through_scope_fail_8>},
+    {"unwind/scope_exit/8", &unwind<&throw_through_scope_exit_8>},
+    {"unwind/try_catch/1", &unwind<&throw_through_try_catch_1>},
+    {"unwind/try_catch/8", &unwind<&throw_through_try_catch_8>},
+    {"unwind/std_function/8", &unwind<&throw_through_std_function_8>},
+};
+
+struct sample {
+  double real_ns;
+  double cpu_ns;
+};
+
+sample measure(const benchmark& b, std::size_t iterations) {
+  const std::clock_t cpu_start = std::clock();
+  const auto real_start = std::chrono::steady_clock::now();
+  b.run(iterations);
+  const auto real_end = std::chrono::steady_clock::now();
+  const std::clock_t cpu_end = std::clock();
+
+  const double real_ns = std::chrono::duration<double, std::nano>(real_end - real_start).count();
+  const double cpu_ns = static_cast<double>(cpu_end - cpu_start) * 1e9 / CLOCKS_PER_SEC;
+  return {real_ns, cpu_ns};
+}
+
+struct result {
+  std::string name;
+  std::size_t iterations;
+  std::size_t repetitions;
+  double real_ns;     // Median per iteration.
+  double cpu_ns;      // Median per iteration.
+  double real_min_ns; // Fastest repetition per iteration.
+};
+
+result run(const benchmark& b, double min_time, std::size_t repetitions) {
+  // Grow the iteration count until a single run takes at least min_time.
+  std::size_t iterations = 1;
+  for (;;) {
+    const sample s = measure(b, iterations);
+    if (s.real_ns >= min_time * 1e9 || iterations >= (std::size_t{1} << 40)) {
+      break;
+    }
+    const double scale = s.real_ns > 0.0 ? (min_time * 1e9 * 1.4) / s.real_ns : 10.0;
+    iterations = static_cast<std::size_t>(static_cast<double>(iterations) * std::min(std::max(scale, 2.0), 10.0));
+  }
+
+  std::vector<sample> samples;
+  for (std::size_t i = 0; i < repetitions; ++i) {
+    sample s = measure(b, iterations);
+    s.real_ns /= static_cast<double>(iterations);
+    s.cpu_ns /= static_cast<double>(iterations);
+    samples.push_back(s);
+  }
+
+  std::sort(samples.begin(), samples.end(), [](const sample& l, const sample& r) { return l.real_ns < r.real_ns; });
+  const sample& median = samples[samples.size() / 2];
+  return {b.name, iterations, repetitions, median.real_ns, median.cpu_ns, samples.front().real_ns};
+}
+
+const char* compiler_name() {
+#if defined(__clang__)
+  return "clang " __clang_version__;
+#elif defined(__GNUC__)
+  return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+#  define BENCH_STR_(x) #x
+#  define BENCH_STR(x)  BENCH_STR_(x)
+  return "msvc " BENCH_STR(_MSC_FULL_VER);
+#else
+  return "unknown";
+#endif
+}
+
+long cplusplus_version() {
+#if defined(_MSVC_LANG)
+  return static_cast<long>(_MSVC_LANG);
+#else
+  return static_cast<long>(__cplusplus);
+#endif
+}
+
+void write_json(std::FILE* out, const std::vector<result>& results) {
+  char date[64] = {};
+  const std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+  std::fprintf(out, "{\n  \"context\": {\n");
+  std::fprintf(out, "    \"date\": \"%s\",\n", date);
+  std::fprintf(out, "    \"executable\": \"scope_guard-bench\",\n");
+  std::fprintf(out, "    \"scope_guard_version\": \"%d.%d.%d\",\n", SCOPE_GUARD_VERSION_MAJOR, SCOPE_GUARD_VERSION_MINOR, SCOPE_GUARD_VERSION_PATCH);
+  std::fprintf(out, "    \"compiler\": \"%s\",\n", compiler_name());
+  std::fprintf(out, "    \"cplusplus\": %ld,\n", cplusplus_version());
+#if defined(NDEBUG)
+  std::fprintf(out, "    \"library_build_type\": \"release\"\n");
+#else
+  std::fprintf(out, "    \"library_build_type\": \"debug\"\n");
+#endif
+  std::fprintf(out, "  },\n  \"benchmarks\": [\n");
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const result& r = results[i];
+    std::fprintf(out, "    {\n");
+    std::fprintf(out, "      \"name\": \"%s\",\n", r.name.c_str());
+    std::fprintf(out, "      \"run_name\": \"%s\",\n", r.name.c_str());
+    std::fprintf(out, "      \"run_type\": \"iteration\",\n");
+    std::fprintf(out, "      \"repetitions\": %zu,\n", r.repetitions);
+    std::fprintf(out, "      \"iterations\": %zu,\n", r.iterations);
+    std::fprintf(out, "      \"real_time\": %.4f,\n", r.real_ns);
+    std::fprintf(out, "      \"cpu_time\": %.4f,\n", r.cpu_ns);
+    std::fprintf(out, "      \"real_time_min\": %.4f,\n", r.real_min_ns);
+    std::fprintf(out, "      \"time_unit\": \"ns\"\n");
+    std::fprintf(out, "    }%s\n", i + 1 == results.size() ? "" : ",");
+  }
+  std::fprintf(out, "  ]\n}\n");
+}
+
+void write_table(std::FILE* out, const std::vector<result>& results) {
+  std::fprintf(out, "%-40s %14s %14s %14s\n", "Benchmark", "Time (ns)", "CPU (ns)", "Iterations");
+  for (const result& r : results) {
+    std::fprintf(out, "%-40s %14.3f %14.3f %14zu\n", r.name.c_str(), r.real_ns, r.cpu_ns, r.iterations);
+  }
+}
+
+bool parse_flag(const char* arg, const char* flag, const char** value) {
+  const std::size_t length = std::strlen(flag);
+  if (std::strncmp(arg, flag, length) == 0 && arg[length] == '=') {
+    *value = arg + length + 1;
+    return true;
+  }
+  return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const char* filter = "";
+  const char* out_path = nullptr;
+  double min_time = 0.1;
+  std::size_t repetitions = 5;
+
+  for (int i = 1; i < argc; ++i) {
+    const char* value = nullptr;
+    if (parse_flag(argv[i], "--benchmark_filter", &value)) {
+      filter = value;
+    } else if (parse_flag(argv[i], "--benchmark_out", &value)) {
+      out_path = value;
+    } else if (parse_flag(argv[i], "--benchmark_min_time", &value)) {
+      min_time = std::atof(value);
+    } else if (parse_flag(argv[i], "--benchmark_repetitions", &value)) {
+      repetitions = static_cast<std::size_t>(std::max(1, std::atoi(value)));
+    } else {
+      std::fprintf(stderr, "unknown argument: %s\n", argv[i]);
+      return 2;
+    }
+  }
+
+  std::vector<result> results;
+  for (const benchmark& b : benchmarks) {
+    if (std::strstr(b.name, filter) != nullptr) {
+      results.push_back(run(b, min_time, repetitions));
+    }
+  }
+
+  if (out_path == nullptr) {
+    write_json(stdout, results);
+    return 0;
+  }
+
+  std::FILE* out = std::fopen(out_path, "w");
+  if (out == nullptr) {
+    std::fprintf(stderr, "can not open %s\n", out_path);
+    return 1;
+  }
+  write_json(out, results);
+  std::fclose(out);
+  write_table(stdout, results);
+
+  return 0;
+}
@@ -0,0 +1,37 @@
+# Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+# SPDX-License-Identifier: MIT
+
+# Reports .text size and defined symbol count of OBJECTS (a list of label=path) into OUTPUT.
+
+set(report "| object | .text bytes | defined symbols |\n|---|---:|---:|\n")
+foreach(entry ${OBJECTS})
+    string(REGEX REPLACE "=.*$" "" label "${entry}")
+    string(REGEX REPLACE "^[^=]*=" "" object "${entry}")
+
+    set(text "n/a")
+    if(SIZE)
+        execute_process(COMMAND ${SIZE} -A ${object} OUTPUT_VARIABLE sections RESULT_VARIABLE status)
+        if(NOT status EQUAL 0)
+            message(FATAL_ERROR "${SIZE} failed on ${object}")
+        endif()
+        set(text 0)
+        string(REGEX MATCHALL "\n\\.text[^ \n]*[ ]+[0-9]+" lines "${sections}")
+        foreach(line ${lines})
+            string(REGEX MATCH "[0-9]+$" bytes "${line}")
+            math(EXPR text "${text} + ${bytes}")
+        endforeach()
+    endif()
+
+    execute_process(COMMAND ${NM} --defined-only ${object} OUTPUT_VARIABLE symbols RESULT_VARIABLE status)
+    if(NOT status EQUAL 0)
+        message(FATAL_ERROR "${NM} failed on ${object}")
+    endif()
+    string(REGEX MATCHALL "\n" newlines "\n${symbols}")
+    list(LENGTH newlines count)
+    math(EXPR count "${count} - 1")
+
+    string(APPEND report "| ${label} | ${text} | ${count} |\n")
+endforeach()
+
+file(WRITE ${OUTPUT} "${report}")
+message("${report}")
@@ -0,0 +1,44 @@
+# Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+# SPDX-License-Identifier: MIT
+
+# Compiles every source in SOURCES with CXX for every standard in STANDARDS, REPETITIONS times,
+# and reports the fastest wall time into OUTPUT. FLAGS and INCLUDE are passed to the compiler.
+
+if(NOT REPETITIONS)
+    set(REPETITIONS 3)
+endif()
+
+function(now_us result)
+    # One TIMESTAMP call, so that seconds and microseconds are taken from the same clock reading.
+    string(TIMESTAMP stamp "%s;%f" UTC)
+    list(GET stamp 0 seconds)
+    list(GET stamp 1 micros)
+    math(EXPR value "${seconds} * 1000000 + ${micros}")
+    set(${result} ${value} PARENT_SCOPE)
+endfunction()
+
+set(report "| source | standard | best ms |\n|---|---|---:|\n")
+foreach(source ${SOURCES})
+    get_filename_component(name ${source} NAME_WE)
+    foreach(standard ${STANDARDS})
+        set(best "")
+        foreach(i RANGE 1 ${REPETITIONS})
+            now_us(start)
+            execute_process(COMMAND ${CXX} ${FLAGS} -std=${standard} -I${INCLUDE} -c ${source} -o ${WORK_DIR}/${name}-${standard}.o
+                            RESULT_VARIABLE status
+                            ERROR_VARIABLE errors)
+            now_us(stop)
+            if(NOT status EQUAL 0)
+                message(FATAL_ERROR "Failed to compile ${source} with -std=${standard}:\n${errors}")
+            endif()
+            math(EXPR elapsed "(${stop} - ${start}) / 1000")
+            if(best STREQUAL "" OR elapsed LESS best)
+                set(best ${elapsed})
+            endif()
+        endforeach()
+        string(APPEND report "| ${name} | ${standard} | ${best} |\n")
+    endforeach()
+endforeach()
+
+file(WRITE ${OUTPUT} "${report}")
+message("${report}")
@@ -0,0 +1,30 @@
+# Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+# SPDX-License-Identifier: MIT
+
+# scope_guard_generate_guards_tu(<output> <guards>) writes a translation unit with <guards> guards,
+# four per function: SCOPE_EXIT, SCOPE_FAIL, SCOPE_SUCCESS and a dismissed MAKE_SCOPE_EXIT.
+function(scope_guard_generate_guards_tu output guards)
+    math(EXPR functions "(${guards} + 3) / 4")
+    set(source "// Generated by bench/generate_guards.cmake, ${guards} guards.\n\n#include <scope_guard.hpp>\n\nvoid sink(int* value);\n")
+    foreach(i RANGE 1 ${functions})
+        string(APPEND source "
+void guards_${i}(int& a, int& b) {
+  SCOPE_EXIT{ a += ${i}; };
+  SCOPE_FAIL{ b -= ${i}; };
+  SCOPE_SUCCESS{ a ^= b; };
+  MAKE_SCOPE_EXIT(rollback){ b += a; };
+  sink(&a);
+  if (a > ${i}) {
+    rollback.dismiss();
+  }
+}
+")
+    endforeach()
+    if(EXISTS ${output})
+        file(READ ${output} existing)
+        if(existing STREQUAL source)
+            return()
+        endif()
+    endif()
+    file(WRITE ${output} "${source}")
+endfunction()
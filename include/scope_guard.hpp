@@ -36,10 +36,26 @@
 #define SCOPE_GUARD_VERSION_MINOR 9
 #define SCOPE_GUARD_VERSION_PATCH 4
 
+// NEARGYE_SCOPE_GUARD_NO_EXCEPTIONS exceptions are disabled, no exception runtime symbols are referenced.
+#if defined(SCOPE_GUARD_NO_EXCEPTIONS) || !(defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND))
+#  define NEARGYE_SCOPE_GUARD_NO_EXCEPTIONS
+#endif
+
+// NEARGYE_SCOPE_GUARD_ITANIUM_EH_GLOBALS uncaught exceptions count is read from __cxa_eh_globals of the Itanium C++ ABI.
+#if (defined(__clang__) || defined(__GNUC__)) && !defined(_MSC_VER) && !defined(NEARGYE_SCOPE_GUARD_NO_EXCEPTIONS)
+#  define NEARGYE_SCOPE_GUARD_ITANIUM_EH_GLOBALS
+#endif
+
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if defined(NEARGYE_SCOPE_GUARD_NO_EXCEPTIONS)
+#include <cstdlib>
+#endif
+#include <new>
 #include <type_traits>
 #include <utility>
-#if (defined(_MSC_VER) && _MSC_VER >= 1900) || ((defined(__clang__) || defined(__GNUC__)) && __cplusplus >= 201700L)
+#if !defined(NEARGYE_SCOPE_GUARD_NO_EXCEPTIONS) && ((defined(_MSC_VER) && _MSC_VER >= 1900) || (__cplusplus >= 201700L && (!defined(NEARGYE_SCOPE_GUARD_ITANIUM_EH_GLOBALS) || defined(SCOPE_GUARD_NO_CACHED_EH_GLOBALS))))
 #include <exception>
 #endif
 
@@ -50,6 +66,14 @@
 // SCOPE_GUARD_SUPPRESS_THROW_ACTION exceptions during action will be suppressed.
 // SCOPE_GUARD_CATCH_HANDLER exception handler statement. If SCOPE_GUARD_SUPPRESS_THROW_ACTION is not defined, it will do nothing.
 
+// scope_guard uncaught exceptions settings:
+// SCOPE_GUARD_NO_EXCEPTIONS no-exceptions mode, implied by -fno-exceptions. No uncaught exceptions can exist, so scope_fail never executes and scope_success always executes.
+// SCOPE_GUARD_NO_CACHED_EH_GLOBALS disables caching of the per-thread exception state address on GCC and Clang: since C++17 std::uncaught_exceptions is used instead, before C++17 __cxa_get_globals is called on every read.
+// SCOPE_GUARD_UNCAUGHT_EXCEPTIONS_HOOK name of a noexcept function, declared before including scope_guard.hpp, returning the uncaught exceptions count of the current execution context (e.g. a fiber). scope_fail and scope_success take their baseline and check from it instead of the per-thread count. Must name the same function in every translation unit that defines it.
+
+// scope_guard code placement settings:
+// SCOPE_GUARD_COLD_FAIL_ACTION scope_fail and scope_fail_on actions are invoked through an out of line cold function behind an unlikely branch.
+
 #if !defined(SCOPE_GUARD_MAY_THROW_ACTION) && !defined(SCOPE_GUARD_NO_THROW_ACTION) && !defined(SCOPE_GUARD_SUPPRESS_THROW_ACTION)
 #  define SCOPE_GUARD_MAY_THROW_ACTION
 #elif (defined(SCOPE_GUARD_MAY_THROW_ACTION) + defined(SCOPE_GUARD_NO_THROW_ACTION) + defined(SCOPE_GUARD_SUPPRESS_THROW_ACTION)) > 1
@@ -60,19 +84,34 @@
 #  define SCOPE_GUARD_CATCH_HANDLER /* Suppress exception.*/
 #endif
 
+// NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_BEGIN/END enclose the entities that read the uncaught exceptions count.
+// With SCOPE_GUARD_UNCAUGHT_EXCEPTIONS_HOOK they are put into an inline namespace, so a translation unit with the hook
+// and one without it define distinct entities, instead of two different definitions of the same inline function.
+#if defined(SCOPE_GUARD_UNCAUGHT_EXCEPTIONS_HOOK)
+#  define NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_BEGIN inline namespace uncaught_exceptions_hook {
+#  define NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_END } // namespace uncaught_exceptions_hook
+#else
+#  define NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_BEGIN
+#  define NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_END
+#endif
+
 namespace scope_guard {
 
 namespace detail {
 
-#if defined(SCOPE_GUARD_SUPPRESS_THROW_ACTION) && (defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND))
-#  define NEARGYE_SCOPE_GUARD_NOEXCEPT(...) noexcept
-#  define NEARGYE_SCOPE_GUARD_TRY           try {
-#  define NEARGYE_SCOPE_GUARD_CATCH         } catch (...) { SCOPE_GUARD_CATCH_HANDLER }
-#else
-#  define NEARGYE_SCOPE_GUARD_NOEXCEPT(...) noexcept(__VA_ARGS__)
-#  define NEARGYE_SCOPE_GUARD_TRY
-#  define NEARGYE_SCOPE_GUARD_CATCH
-#endif
+template <typename T>
+struct default_is_trivially_relocatable;
+
+} // namespace scope_guard::detail
+
+// is_trivially_relocatable T can be relocated by copying its bytes, after which the source is not destroyed.
+// True for trivially copyable types and for guards whose action and policy are trivially relocatable.
+// Specialize it for an action that is not trivially copyable, but whose members are trivially relocatable (e.g. std::unique_ptr).
+template <typename T>
+struct is_trivially_relocatable
+    : detail::default_is_trivially_relocatable<T> {};
+
+namespace detail {
 
 #define NEARGYE_SCOPE_GUARD_MOV(...) static_cast<typename std::remove_reference<decltype(__VA_ARGS__)>::type&&>(__VA_ARGS__)
 #define NEARGYE_SCOPE_GUARD_FWD(...) static_cast<decltype(__VA_ARGS__)&&>(__VA_ARGS__)
@@ -104,44 +143,185 @@ namespace detail {
 #  endif
 #endif
 
-#if (defined(__clang__) || defined(__GNUC__)) && __cplusplus < 201700L
+// NEARGYE_SCOPE_GUARD_NO_UNIQUE_ADDRESS allows the policy to be placed in the tail padding of the action.
+#if !defined(NEARGYE_SCOPE_GUARD_NO_UNIQUE_ADDRESS)
+#  if defined(_MSC_VER) && _MSC_VER >= 1929 && defined(_MSVC_LANG) && _MSVC_LANG >= 202002L
+#    define NEARGYE_SCOPE_GUARD_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#  elif !defined(_MSC_VER) && defined(__has_cpp_attribute) && __cplusplus >= 202002L
+#    if __has_cpp_attribute(no_unique_address)
+#      define NEARGYE_SCOPE_GUARD_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#    endif
+#  endif
+#  if !defined(NEARGYE_SCOPE_GUARD_NO_UNIQUE_ADDRESS)
+#    define NEARGYE_SCOPE_GUARD_NO_UNIQUE_ADDRESS
+#  endif
+#endif
+
+// NEARGYE_SCOPE_GUARD_FORCE_INLINE inlines trivial forwarding helpers even without optimizations,
+// so that unoptimized builds do not emit and call a separate function per action type for each of them.
+#if !defined(NEARGYE_SCOPE_GUARD_FORCE_INLINE)
+#  if defined(__clang__) || defined(__GNUC__)
+#    define NEARGYE_SCOPE_GUARD_FORCE_INLINE __attribute__((__always_inline__))
+#  elif defined(_MSC_VER)
+#    define NEARGYE_SCOPE_GUARD_FORCE_INLINE __forceinline
+#  else
+#    define NEARGYE_SCOPE_GUARD_FORCE_INLINE
+#  endif
+#endif
+
+// NEARGYE_SCOPE_GUARD_COLD keeps a rarely executed function out of line and in the cold text section.
+#if !defined(NEARGYE_SCOPE_GUARD_COLD)
+#  if defined(__clang__) || defined(__GNUC__)
+#    define NEARGYE_SCOPE_GUARD_COLD __attribute__((__cold__, __noinline__))
+#  elif defined(_MSC_VER)
+#    define NEARGYE_SCOPE_GUARD_COLD __declspec(noinline)
+#  else
+#    define NEARGYE_SCOPE_GUARD_COLD
+#  endif
+#endif
+
+// NEARGYE_SCOPE_GUARD_UNLIKELY marks a condition that is expected to be false.
+#if !defined(NEARGYE_SCOPE_GUARD_UNLIKELY)
+#  if defined(__clang__) || defined(__GNUC__)
+#    define NEARGYE_SCOPE_GUARD_UNLIKELY(x) __builtin_expect(static_cast<bool>(x), 0)
+#  else
+#    define NEARGYE_SCOPE_GUARD_UNLIKELY(x) (x)
+#  endif
+#endif
+
+// NEARGYE_SCOPE_GUARD_UNLIKELY_BRANCH marks the following branch as unlikely.
+#if !defined(NEARGYE_SCOPE_GUARD_UNLIKELY_BRANCH)
+#  if defined(__has_cpp_attribute) && ((defined(_MSVC_LANG) && _MSVC_LANG >= 202002L) || __cplusplus >= 202002L)
+#    if __has_cpp_attribute(unlikely)
+#      define NEARGYE_SCOPE_GUARD_UNLIKELY_BRANCH [[unlikely]]
+#    endif
+#  endif
+#  if !defined(NEARGYE_SCOPE_GUARD_UNLIKELY_BRANCH)
+#    define NEARGYE_SCOPE_GUARD_UNLIKELY_BRANCH
+#  endif
+#endif
+
+// NEARGYE_SCOPE_GUARD_CONSTEXPR_GUARDS guards, policies and factories are usable in constant evaluation (C++20 constexpr destructors).
+// NEARGYE_SCOPE_GUARD_CONSTEXPR is constexpr then, and empty otherwise.
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201907L && defined(__cpp_lib_is_constant_evaluated) && __cpp_lib_is_constant_evaluated >= 201811L
+#  define NEARGYE_SCOPE_GUARD_CONSTEXPR_GUARDS
+#  define NEARGYE_SCOPE_GUARD_CONSTEXPR constexpr
+#else
+#  define NEARGYE_SCOPE_GUARD_CONSTEXPR
+#endif
+
+// NEARGYE_SCOPE_GUARD_PINNED_GUARDS non-movable guards can be returned from factories by guaranteed copy elision (C++17).
+#if (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L
+#  define NEARGYE_SCOPE_GUARD_PINNED_GUARDS
+#endif
+
+NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_BEGIN
+
+#if defined(NEARGYE_SCOPE_GUARD_NO_EXCEPTIONS)
+inline int runtime_uncaught_exceptions() noexcept {
+  return 0;
+}
+#elif defined(SCOPE_GUARD_UNCAUGHT_EXCEPTIONS_HOOK)
+inline int runtime_uncaught_exceptions() noexcept {
+  return static_cast<int>(SCOPE_GUARD_UNCAUGHT_EXCEPTIONS_HOOK());
+}
+#elif defined(NEARGYE_SCOPE_GUARD_ITANIUM_EH_GLOBALS) && !defined(SCOPE_GUARD_NO_CACHED_EH_GLOBALS)
 struct __cxa_eh_globals;
 extern "C" __cxa_eh_globals* __cxa_get_globals() noexcept;
-inline int uncaught_exceptions() noexcept {
+// The per-thread __cxa_eh_globals never moves, so its uncaughtExceptions field is looked up once per thread.
+// After that runtime_uncaught_exceptions() is an inlined TLS load instead of an out-of-line call.
+inline unsigned int* uncaught_exceptions_counter() noexcept {
+  static thread_local unsigned int* counter = nullptr;
+  if (counter == nullptr) {
+    counter = reinterpret_cast<unsigned int*>(static_cast<char*>(static_cast<void*>(__cxa_get_globals())) + sizeof(void*));
+  }
+  return counter;
+}
+inline int runtime_uncaught_exceptions() noexcept {
+  return static_cast<int>(*uncaught_exceptions_counter());
+}
+#elif defined(NEARGYE_SCOPE_GUARD_ITANIUM_EH_GLOBALS) && __cplusplus < 201700L
+struct __cxa_eh_globals;
+extern "C" __cxa_eh_globals* __cxa_get_globals() noexcept;
+inline int runtime_uncaught_exceptions() noexcept {
   return static_cast<int>(*(reinterpret_cast<unsigned int*>(static_cast<char*>(static_cast<void*>(__cxa_get_globals())) + sizeof(void*))));
 }
 #else
-inline int uncaught_exceptions() noexcept {
+inline int runtime_uncaught_exceptions() noexcept {
   return std::uncaught_exceptions();
 }
 #endif
 
+// No exception can be in flight during constant evaluation, so the exception runtime is not consulted there.
+inline NEARGYE_SCOPE_GUARD_CONSTEXPR int uncaught_exceptions() noexcept {
+#if defined(NEARGYE_SCOPE_GUARD_CONSTEXPR_GUARDS)
+  if (std::is_constant_evaluated()) {
+    return 0;
+  }
+#endif
+  return runtime_uncaught_exceptions();
+}
+
 class on_exit_policy {
   bool execute_;
 
  public:
-  explicit on_exit_policy(bool execute) noexcept : execute_{execute} {}
+  NEARGYE_SCOPE_GUARD_CONSTEXPR explicit on_exit_policy(bool execute) noexcept : execute_{execute} {}
 
-  void dismiss() noexcept {
+  NEARGYE_SCOPE_GUARD_CONSTEXPR void dismiss() noexcept {
     execute_ = false;
   }
 
-  bool should_execute() const noexcept {
+  NEARGYE_SCOPE_GUARD_CONSTEXPR bool should_execute() const noexcept {
     return execute_;
   }
 };
 
+// on_exit_always_policy is used by guards that can not be dismissed (SCOPE_EXIT, DEFER, WITH_SCOPE_EXIT).
+// It has no state, so such a guard occupies sizeof(action) and always executes without a flag check.
+class on_exit_always_policy {
+ public:
+  NEARGYE_SCOPE_GUARD_CONSTEXPR explicit on_exit_always_policy(bool) noexcept {}
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR bool should_execute() const noexcept {
+    return true;
+  }
+};
+
+// scope_fail_region captures the uncaught exceptions baseline once for many scope_fail/scope_success guards.
+// Guards created with the region copy its baseline instead of reading the exception state again,
+// so it must be created in the same frame as the guards, before them.
+class scope_fail_region {
+  int ec_;
+
+ public:
+  NEARGYE_SCOPE_GUARD_CONSTEXPR scope_fail_region() noexcept : ec_{uncaught_exceptions()} {}
+
+  scope_fail_region(const scope_fail_region&) = delete;
+  scope_fail_region& operator=(const scope_fail_region&) = delete;
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR int baseline() const noexcept {
+    return ec_;
+  }
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR bool failed() const noexcept {
+    return ec_ < uncaught_exceptions();
+  }
+};
+
 class on_fail_policy {
   int ec_;
 
  public:
-  explicit on_fail_policy(bool execute) noexcept : ec_{execute ? uncaught_exceptions() : -1} {}
+  NEARGYE_SCOPE_GUARD_CONSTEXPR explicit on_fail_policy(bool execute) noexcept : ec_{execute ? uncaught_exceptions() : -1} {}
 
-  void dismiss() noexcept {
+  NEARGYE_SCOPE_GUARD_CONSTEXPR explicit on_fail_policy(const scope_fail_region& region) noexcept : ec_{region.baseline()} {}
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR void dismiss() noexcept {
     ec_ = -1;
   }
 
-  bool should_execute() const noexcept {
+  NEARGYE_SCOPE_GUARD_CONSTEXPR bool should_execute() const noexcept {
     return ec_ != -1 && ec_ < uncaught_exceptions();
   }
 };
@@ -150,17 +330,154 @@ class on_success_policy {
   int ec_;
 
  public:
-  explicit on_success_policy(bool execute) noexcept : ec_{execute ? uncaught_exceptions() : -1} {}
+  NEARGYE_SCOPE_GUARD_CONSTEXPR explicit on_success_policy(bool execute) noexcept : ec_{execute ? uncaught_exceptions() : -1} {}
 
-  void dismiss() noexcept {
+  NEARGYE_SCOPE_GUARD_CONSTEXPR explicit on_success_policy(const scope_fail_region& region) noexcept : ec_{region.baseline()} {}
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR void dismiss() noexcept {
     ec_ = -1;
   }
 
-  bool should_execute() const noexcept {
+  NEARGYE_SCOPE_GUARD_CONSTEXPR bool should_execute() const noexcept {
     return ec_ != -1 && ec_ >= uncaught_exceptions();
   }
 };
 
+// on_fail_pinned_policy/on_success_pinned_policy are used by guards that can be neither moved nor dismissed (make_pinned_scope_fail/success).
+// The exception baseline is their only state, so there is no dismissed value to check.
+class on_fail_pinned_policy {
+  int ec_;
+
+ public:
+  NEARGYE_SCOPE_GUARD_CONSTEXPR explicit on_fail_pinned_policy(bool) noexcept : ec_{uncaught_exceptions()} {}
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR bool should_execute() const noexcept {
+    return ec_ < uncaught_exceptions();
+  }
+};
+
+class on_success_pinned_policy {
+  int ec_;
+
+ public:
+  NEARGYE_SCOPE_GUARD_CONSTEXPR explicit on_success_pinned_policy(bool) noexcept : ec_{uncaught_exceptions()} {}
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR bool should_execute() const noexcept {
+    return ec_ >= uncaught_exceptions();
+  }
+};
+
+NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_END
+
+// scope_transaction is a commit flag shared by the rollback guards attached to it, so commit() dismisses all of them with one store.
+class scope_transaction {
+  bool committed_;
+
+ public:
+  NEARGYE_SCOPE_GUARD_CONSTEXPR scope_transaction() noexcept : committed_{false} {}
+
+  scope_transaction(const scope_transaction&) = delete;
+  scope_transaction& operator=(const scope_transaction&) = delete;
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR void commit() noexcept {
+    committed_ = true;
+  }
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR bool committed() const noexcept {
+    return committed_;
+  }
+};
+
+class on_rollback_policy {
+  const scope_transaction* transaction_;
+
+ public:
+  NEARGYE_SCOPE_GUARD_CONSTEXPR explicit on_rollback_policy(const scope_transaction& transaction) noexcept : transaction_{&transaction} {}
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR void dismiss() noexcept {
+    transaction_ = nullptr;
+  }
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR bool should_execute() const noexcept {
+    return transaction_ != nullptr && !transaction_->committed();
+  }
+};
+
+template <typename T, typename = void>
+struct is_expected_like_status
+    : std::false_type {};
+
+template <typename T>
+struct is_expected_like_status<T, decltype(static_cast<void>(static_cast<bool>(std::declval<const T&>().has_value())))>
+    : std::true_type {};
+
+template <typename T, typename = void>
+struct is_error_code_like_status
+    : std::false_type {};
+
+template <typename T>
+struct is_error_code_like_status<T, decltype(static_cast<void>(std::declval<const T&>().value() != 0), static_cast<void>(std::declval<const T&>().category()))>
+    : std::true_type {};
+
+// status_failed decides failure from a bound status object:
+// bool is a success flag, an expected-like result failed if it has no value, an error_code-like status failed if its value is not zero.
+template <typename S>
+NEARGYE_SCOPE_GUARD_CONSTEXPR bool status_failed(const S& status, typename std::enable_if<std::is_same<S, bool>::value, int>::type = 0) noexcept {
+  return !status;
+}
+
+template <typename S>
+NEARGYE_SCOPE_GUARD_CONSTEXPR bool status_failed(const S& status, typename std::enable_if<is_expected_like_status<S>::value, int>::type = 0) noexcept {
+  return !status.has_value();
+}
+
+template <typename S>
+NEARGYE_SCOPE_GUARD_CONSTEXPR bool status_failed(const S& status, typename std::enable_if<!is_expected_like_status<S>::value && is_error_code_like_status<S>::value, int>::type = 0) noexcept {
+  return status.value() != 0;
+}
+
+template <typename S>
+struct is_status
+    : std::integral_constant<bool, std::is_same<S, bool>::value || is_expected_like_status<S>::value || is_error_code_like_status<S>::value> {};
+
+// on_status_fail_policy/on_status_success_policy decide from a bound status object instead of the uncaught exceptions count,
+// so they do not touch the exception runtime and work with exceptions disabled.
+template <typename S>
+class on_status_fail_policy {
+  static_assert(is_status<S>::value, "scope_fail_on requires a bool success flag, an expected-like or an error_code-like status.");
+
+  const S* status_;
+
+ public:
+  NEARGYE_SCOPE_GUARD_CONSTEXPR explicit on_status_fail_policy(const S& status) noexcept : status_{&status} {}
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR void dismiss() noexcept {
+    status_ = nullptr;
+  }
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR bool should_execute() const noexcept {
+    return status_ != nullptr && status_failed(*status_);
+  }
+};
+
+template <typename S>
+class on_status_success_policy {
+  static_assert(is_status<S>::value, "scope_success_on requires a bool success flag, an expected-like or an error_code-like status.");
+
+  const S* status_;
+
+ public:
+  NEARGYE_SCOPE_GUARD_CONSTEXPR explicit on_status_success_policy(const S& status) noexcept : status_{&status} {}
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR void dismiss() noexcept {
+    status_ = nullptr;
+  }
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR bool should_execute() const noexcept {
+    return status_ != nullptr && !status_failed(*status_);
+  }
+};
+
 template <typename T, typename = void>
 struct is_noarg_returns_void_action
     : std::false_type {};
@@ -169,6 +486,26 @@ template <typename T>
 struct is_noarg_returns_void_action<T, decltype((std::declval<T>())())>
     : std::true_type {};
 
+template <bool...>
+struct bool_pack;
+
+template <bool... B>
+struct all_of
+    : std::is_same<bool_pack<true, B...>, bool_pack<B..., true>> {};
+
+// Constraint on factory and macro arguments. With concepts the check is a cached atomic constraint
+// instead of a class template instantiation per action type.
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+template <typename F>
+concept noarg_returns_void_action = std::is_void<decltype(std::declval<typename std::decay<F>::type&>()())>::value;
+
+#  define NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F) typename std::enable_if<noarg_returns_void_action<F>, int>::type = 0
+#  define NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTIONS(F) typename std::enable_if<(sizeof...(F) > 1 && (noarg_returns_void_action<F> && ...)), int>::type = 0
+#else
+#  define NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F) typename std::enable_if<is_noarg_returns_void_action<typename std::decay<F>::type&>::value, int>::type = 0
+#  define NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTIONS(F) typename std::enable_if<(sizeof...(F) > 1 && all_of<is_noarg_returns_void_action<typename std::decay<F>::type&>::value...>::value), int>::type = 0
+#endif
+
 template <typename T, bool = is_noarg_returns_void_action<T>::value>
 struct is_nothrow_invocable_action
     : std::false_type {};
@@ -177,25 +514,265 @@ template <typename T>
 struct is_nothrow_invocable_action<T, true>
     : std::integral_constant<bool, noexcept((std::declval<T>())())> {};
 
-template <typename F, typename P>
-class scope_guard {
+template <typename P, typename = void>
+struct is_dismissible_policy
+    : std::false_type {};
+
+template <typename P>
+struct is_dismissible_policy<P, decltype(std::declval<P&>().dismiss())>
+    : std::integral_constant<bool, noexcept(std::declval<P&>().dismiss())> {};
+
+template <typename P, typename = void>
+struct has_should_execute
+    : std::false_type {};
+
+template <typename P>
+struct has_should_execute<P, decltype(static_cast<void>(static_cast<bool>(std::declval<const P&>().should_execute())))>
+    : std::integral_constant<bool, noexcept(static_cast<bool>(std::declval<const P&>().should_execute()))> {};
+
+// A scope_guard policy is a move constructible class with `bool should_execute() const noexcept`.
+// Optional: a constructor from bool, used when the guard is made from an action only;
+// `void dismiss() noexcept`, without it the guard is non-dismissible and non-movable.
+template <typename P>
+struct is_scope_guard_policy
+    : std::integral_constant<bool, std::is_class<P>::value && std::is_move_constructible<P>::value && has_should_execute<P>::value> {};
+
+#if (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L) || __cplusplus >= 201402L
+template <typename T>
+struct is_final : std::is_final<T> {};
+#else
+template <typename T>
+struct is_final : std::integral_constant<bool, __is_final(T)> {};
+#endif
+
+// is_empty_base T can be an empty base class. Compiler intrinsics avoid instantiating three traits per action type.
+#if defined(__clang__) || defined(__GNUC__) || defined(_MSC_VER)
+template <typename T>
+struct is_empty_base
+    : std::integral_constant<bool, __is_class(T) && __is_empty(T) && !__is_final(T)> {};
+#else
+template <typename T>
+struct is_empty_base
+    : std::integral_constant<bool, std::is_class<T>::value && std::is_empty<T>::value && !is_final<T>::value> {};
+#endif
+
+// compressed_element stores an empty class as a base (EBO), anything else as a member.
+template <typename T, int I, bool = is_empty_base<T>::value>
+class compressed_element {
+  NEARGYE_SCOPE_GUARD_NO_UNIQUE_ADDRESS T value_;
+
+ public:
+  template <typename U>
+  NEARGYE_SCOPE_GUARD_FORCE_INLINE NEARGYE_SCOPE_GUARD_CONSTEXPR explicit compressed_element(U&& value) : value_{NEARGYE_SCOPE_GUARD_FWD(value)} {}
+
+  NEARGYE_SCOPE_GUARD_FORCE_INLINE NEARGYE_SCOPE_GUARD_CONSTEXPR T& get() noexcept {
+    return value_;
+  }
+
+  NEARGYE_SCOPE_GUARD_FORCE_INLINE NEARGYE_SCOPE_GUARD_CONSTEXPR const T& get() const noexcept {
+    return value_;
+  }
+};
+
+template <typename T, int I>
+class compressed_element<T, I, true> : private T {
+ public:
+  template <typename U>
+  NEARGYE_SCOPE_GUARD_FORCE_INLINE NEARGYE_SCOPE_GUARD_CONSTEXPR explicit compressed_element(U&& value) : T{NEARGYE_SCOPE_GUARD_FWD(value)} {}
+
+  NEARGYE_SCOPE_GUARD_FORCE_INLINE NEARGYE_SCOPE_GUARD_CONSTEXPR T& get() noexcept {
+    return *this;
+  }
+
+  NEARGYE_SCOPE_GUARD_FORCE_INLINE NEARGYE_SCOPE_GUARD_CONSTEXPR const T& get() const noexcept {
+    return *this;
+  }
+};
+
+// Throw policies of the action, selected per guard by the last template parameter of scope_guard.
+// SCOPE_GUARD_MAY_THROW_ACTION, SCOPE_GUARD_NO_THROW_ACTION and SCOPE_GUARD_SUPPRESS_THROW_ACTION only choose default_throw_action.
+
+// may_throw_action the action may throw, the guard destructor is noexcept only if the action is.
+struct may_throw_action {
+  template <typename A>
+  NEARGYE_SCOPE_GUARD_FORCE_INLINE NEARGYE_SCOPE_GUARD_CONSTEXPR static void invoke(A& action) noexcept(is_nothrow_invocable_action<A&>::value) {
+    action();
+  }
+};
+
+// no_throw_action requires a noexcept action, the guard destructor is noexcept and has no landing pad.
+struct no_throw_action {
+  template <typename A>
+  NEARGYE_SCOPE_GUARD_FORCE_INLINE NEARGYE_SCOPE_GUARD_CONSTEXPR static void invoke(A& action) noexcept {
+    static_assert(is_nothrow_invocable_action<A&>::value,
+                  "scope_guard requires noexcept invocable action.");
+    action();
+  }
+};
+
+// suppress_throw_action exceptions during action are suppressed and passed to SCOPE_GUARD_CATCH_HANDLER.
+struct suppress_throw_action {
+  template <typename A>
+  NEARGYE_SCOPE_GUARD_CONSTEXPR static void invoke(A& action) noexcept {
+#if defined(NEARGYE_SCOPE_GUARD_NO_EXCEPTIONS)
+    action();
+#else
+    try {
+      action();
+    } catch (...) {
+      SCOPE_GUARD_CATCH_HANDLER
+    }
+#endif
+  }
+};
+
+// cold_action invokes the action out of line, so that an action expected not to execute is not inlined into the hot path.
+template <typename T>
+struct cold_action {
+  template <typename A>
+  NEARGYE_SCOPE_GUARD_COLD NEARGYE_SCOPE_GUARD_CONSTEXPR static void invoke(A& action) noexcept(noexcept(T::invoke(action))) {
+    T::invoke(action);
+  }
+};
+
+// is_cold_policy the action is expected not to execute, with SCOPE_GUARD_COLD_FAIL_ACTION it is invoked through cold_action.
+template <typename P>
+struct is_cold_policy
+    : std::false_type {};
+
+#if defined(SCOPE_GUARD_COLD_FAIL_ACTION)
+template <>
+struct is_cold_policy<on_fail_policy>
+    : std::true_type {};
+
+template <>
+struct is_cold_policy<on_fail_pinned_policy>
+    : std::true_type {};
+
+template <>
+struct is_cold_policy<on_rollback_policy>
+    : std::true_type {};
+
+template <typename S>
+struct is_cold_policy<on_status_fail_policy<S>>
+    : std::true_type {};
+#endif
+
+#if defined(SCOPE_GUARD_NO_THROW_ACTION)
+using default_throw_action = no_throw_action;
+#elif defined(SCOPE_GUARD_SUPPRESS_THROW_ACTION)
+using default_throw_action = suppress_throw_action;
+#else
+using default_throw_action = may_throw_action;
+#endif
+
+template <typename T>
+struct is_throw_policy
+    : std::integral_constant<bool, std::is_same<T, may_throw_action>::value || std::is_same<T, no_throw_action>::value || std::is_same<T, suppress_throw_action>::value> {};
+
+// action_group holds several actions in one object, so that a guard checks its policy once for all of them.
+// The actions are invoked in reverse order, each through the throw policy T; if an action throws, the actions before it still run.
+template <typename T, typename... A>
+class action_group;
+
+template <typename T>
+class action_group<T> {
+ public:
+  NEARGYE_SCOPE_GUARD_FORCE_INLINE NEARGYE_SCOPE_GUARD_CONSTEXPR void operator()() noexcept {}
+};
+
+// The rest of the group is a base constructed in place, the first action is stored with the index of its position from the end,
+// so that equal actions do not repeat a base class.
+template <typename T, typename A, typename... R>
+class action_group<T, A, R...> : private compressed_element<A, sizeof...(R)>, private action_group<T, R...> {
+  using first_storage = compressed_element<A, sizeof...(R)>;
+  using rest_group = action_group<T, R...>;
+
+  static_assert(is_noarg_returns_void_action<A&>::value,
+                "scope_guard requires no-argument action, that returns void.");
+  static_assert(!std::is_same<T, no_throw_action>::value || is_nothrow_invocable_action<A&>::value,
+                "scope_guard requires noexcept invocable action.");
+
+  static constexpr bool nothrow_first = noexcept(T::invoke(std::declval<A&>()));
+  static constexpr bool nothrow_rest = noexcept(std::declval<rest_group&>()());
+
+  // Invokes the first action after the rest, even if one of them throws.
+  struct continuation {
+    A& action;
+
+    NEARGYE_SCOPE_GUARD_CONSTEXPR ~continuation() noexcept(nothrow_first) {
+      T::invoke(action);
+    }
+  };
+
+  NEARGYE_SCOPE_GUARD_FORCE_INLINE NEARGYE_SCOPE_GUARD_CONSTEXPR void invoke(std::true_type) noexcept(nothrow_first) {
+    rest_group::operator()();
+    T::invoke(first_storage::get());
+  }
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR void invoke(std::false_type) noexcept(nothrow_first && nothrow_rest) {
+    continuation c{first_storage::get()};
+    rest_group::operator()();
+  }
+
+ public:
+  NEARGYE_SCOPE_GUARD_CONSTEXPR action_group(A&& first, R&&... rest) noexcept(std::is_nothrow_move_constructible<A>::value && std::is_nothrow_constructible<rest_group, R&&...>::value)
+      : first_storage{NEARGYE_SCOPE_GUARD_MOV(first)},
+        rest_group{NEARGYE_SCOPE_GUARD_MOV(rest)...} {}
+
+  NEARGYE_SCOPE_GUARD_FORCE_INLINE NEARGYE_SCOPE_GUARD_CONSTEXPR void operator()() noexcept(nothrow_first && nothrow_rest) {
+    invoke(std::integral_constant<bool, nothrow_rest>{});
+  }
+};
+
+// Guard with a non-dismissible policy can not be moved: the moved-from guard would execute the action too.
+struct not_movable_scope_guard;
+
+struct scope_guard_construct_tag {};
+
+// The action is stored first, so that with [[no_unique_address]] the policy can reuse its tail padding.
+template <typename F, typename P, typename T = default_throw_action>
+class scope_guard : private compressed_element<typename std::decay<F>::type, 0>, private compressed_element<P, 1> {
   using A = typename std::decay<F>::type;
+  using action_storage = compressed_element<A, 0>;
+  using policy_storage = compressed_element<P, 1>;
 
   static_assert(is_noarg_returns_void_action<A&>::value,
                 "scope_guard requires no-argument action, that returns void.");
-  static_assert(std::is_same<P, on_exit_policy>::value || std::is_same<P, on_fail_policy>::value || std::is_same<P, on_success_policy>::value,
-                "scope_guard requires on_exit_policy, on_fail_policy or on_success_policy.");
-#if defined(SCOPE_GUARD_NO_THROW_ACTION)
-  static_assert(is_nothrow_invocable_action<A&>::value,
+  static_assert(is_scope_guard_policy<P>::value,
+                "scope_guard requires move constructible policy with bool should_execute() const noexcept.");
+  static_assert(is_throw_policy<T>::value,
+                "scope_guard requires may_throw_action, no_throw_action or suppress_throw_action.");
+  static_assert(!std::is_same<T, no_throw_action>::value || is_nothrow_invocable_action<A&>::value,
                 "scope_guard requires noexcept invocable action.");
-#endif
 #if defined(SCOPE_GUARD_NO_THROW_CONSTRUCTIBLE)
   static_assert(std::is_nothrow_move_constructible<A>::value,
                 "scope_guard requires nothrow constructible action.");
 #endif
 
-  P policy_;
-  A action_;
+  using move_type = typename std::conditional<is_dismissible_policy<P>::value, scope_guard, not_movable_scope_guard>::type;
+
+  NEARGYE_SCOPE_GUARD_FORCE_INLINE NEARGYE_SCOPE_GUARD_CONSTEXPR A& action() noexcept {
+    return action_storage::get();
+  }
+
+  NEARGYE_SCOPE_GUARD_FORCE_INLINE NEARGYE_SCOPE_GUARD_CONSTEXPR P& policy() noexcept {
+    return policy_storage::get();
+  }
+
+#if defined(SCOPE_GUARD_COLD_FAIL_ACTION)
+  NEARGYE_SCOPE_GUARD_CONSTEXPR void execute(std::false_type) noexcept(noexcept(T::invoke(std::declval<A&>()))) {
+    if (policy().should_execute()) {
+      T::invoke(action());
+    }
+  }
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR void execute(std::true_type) noexcept(noexcept(T::invoke(std::declval<A&>()))) {
+    if (NEARGYE_SCOPE_GUARD_UNLIKELY(policy().should_execute())) NEARGYE_SCOPE_GUARD_UNLIKELY_BRANCH {
+      cold_action<T>::invoke(action());
+    }
+  }
+#endif
 
   void* operator new(std::size_t) = delete;
   void operator delete(void*) = delete;
@@ -206,93 +783,758 @@ class scope_guard {
   scope_guard& operator=(const scope_guard&) = delete;
   scope_guard& operator=(scope_guard&&) = delete;
 
-  scope_guard(scope_guard&& other) noexcept(std::is_nothrow_move_constructible<A>::value)
-      : policy_{false},
-        action_{NEARGYE_SCOPE_GUARD_MOV(other.action_)} {
-    policy_ = NEARGYE_SCOPE_GUARD_MOV(other.policy_);
-    other.policy_.dismiss();
+  NEARGYE_SCOPE_GUARD_CONSTEXPR scope_guard(move_type&& other) noexcept(std::is_nothrow_move_constructible<A>::value && std::is_nothrow_move_constructible<P>::value)
+      : action_storage{NEARGYE_SCOPE_GUARD_MOV(other.action())},
+        policy_storage{NEARGYE_SCOPE_GUARD_MOV(other.policy())} {
+    other.policy().dismiss();
   }
 
   scope_guard(const A& action) = delete;
   scope_guard(A& action) = delete;
 
-  explicit scope_guard(A&& action) noexcept(std::is_nothrow_move_constructible<A>::value)
-      : policy_{true},
-        action_{NEARGYE_SCOPE_GUARD_MOV(action)} {}
+  NEARGYE_SCOPE_GUARD_CONSTEXPR explicit scope_guard(A&& action) noexcept(std::is_nothrow_move_constructible<A>::value)
+      : action_storage{NEARGYE_SCOPE_GUARD_MOV(action)},
+        policy_storage{true} {}
 
-  void dismiss() noexcept {
-    policy_.dismiss();
+  NEARGYE_SCOPE_GUARD_CONSTEXPR scope_guard(A&& action, P&& policy) noexcept(std::is_nothrow_move_constructible<A>::value && std::is_nothrow_move_constructible<P>::value)
+      : action_storage{NEARGYE_SCOPE_GUARD_MOV(action)},
+        policy_storage{NEARGYE_SCOPE_GUARD_MOV(policy)} {}
+
+  // Non-explicit, so that a non-movable guard can be returned by copy-list-initialization.
+  NEARGYE_SCOPE_GUARD_CONSTEXPR scope_guard(scope_guard_construct_tag, A&& action) noexcept(std::is_nothrow_move_constructible<A>::value)
+      : action_storage{NEARGYE_SCOPE_GUARD_MOV(action)},
+        policy_storage{true} {}
+
+  NEARGYE_SCOPE_GUARD_CONSTEXPR void dismiss() noexcept {
+    policy().dismiss();
   }
 
-  ~scope_guard() NEARGYE_SCOPE_GUARD_NOEXCEPT(is_nothrow_invocable_action<A&>::value) {
-    if (policy_.should_execute()) {
-      NEARGYE_SCOPE_GUARD_TRY
-        action_();
-      NEARGYE_SCOPE_GUARD_CATCH
+  NEARGYE_SCOPE_GUARD_CONSTEXPR ~scope_guard() noexcept(noexcept(T::invoke(std::declval<A&>()))) {
+#if defined(SCOPE_GUARD_COLD_FAIL_ACTION)
+    execute(is_cold_policy<P>{});
+#else
+    if (policy().should_execute()) {
+      T::invoke(action());
     }
+#endif
   }
 };
 
-template <typename F>
-using scope_exit = scope_guard<F, on_exit_policy>;
+// scope_group is a guard for several actions, made by the variadic factories.
+template <typename P, typename T, typename... F>
+using scope_group = scope_guard<action_group<T, typename std::decay<F>::type...>, P, T>;
+
+template <typename F, typename T = default_throw_action>
+using scope_exit = scope_guard<F, on_exit_policy, T>;
 
-template <typename F, typename std::enable_if<is_noarg_returns_void_action<typename std::decay<F>::type&>::value, int>::type = 0>
-NEARGYE_SCOPE_GUARD_NODISCARD scope_exit<F> make_scope_exit(F&& action) noexcept(noexcept(scope_exit<F>{NEARGYE_SCOPE_GUARD_FWD(action)})) {
+template <typename T = default_throw_action, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR scope_exit<F, T> make_scope_exit(F&& action) noexcept(noexcept(scope_exit<F, T>{NEARGYE_SCOPE_GUARD_FWD(action)})) {
   static_assert(std::is_rvalue_reference<F&&>::value, "make_scope_exit requires an rvalue action; use std::move or pass a temporary.");
-  return scope_exit<F>{NEARGYE_SCOPE_GUARD_FWD(action)};
+  return scope_exit<F, T>{NEARGYE_SCOPE_GUARD_FWD(action)};
 }
 
-template <typename F>
-using scope_fail = scope_guard<F, on_fail_policy>;
+// make_scope_exit(a, b, c) returns one guard for several actions, executed in reverse order.
+template <typename T = default_throw_action, typename... F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTIONS(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR scope_group<on_exit_policy, T, F...> make_scope_exit(F&&... actions) noexcept(noexcept(scope_group<on_exit_policy, T, F...>{action_group<T, typename std::decay<F>::type...>{NEARGYE_SCOPE_GUARD_FWD(actions)...}})) {
+  static_assert(all_of<std::is_rvalue_reference<F&&>::value...>::value, "make_scope_exit requires rvalue actions; use std::move or pass temporaries.");
+  return scope_group<on_exit_policy, T, F...>{action_group<T, typename std::decay<F>::type...>{NEARGYE_SCOPE_GUARD_FWD(actions)...}};
+}
+
+template <typename F, typename T = default_throw_action>
+using scope_defer = scope_guard<F, on_exit_always_policy, T>;
+
+template <typename F, typename T = default_throw_action>
+using scope_fail = scope_guard<F, on_fail_policy, T>;
 
-template <typename F, typename std::enable_if<is_noarg_returns_void_action<typename std::decay<F>::type&>::value, int>::type = 0>
-NEARGYE_SCOPE_GUARD_NODISCARD scope_fail<F> make_scope_fail(F&& action) noexcept(noexcept(scope_fail<F>{NEARGYE_SCOPE_GUARD_FWD(action)})) {
+template <typename T = default_throw_action, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR scope_fail<F, T> make_scope_fail(F&& action) noexcept(noexcept(scope_fail<F, T>{NEARGYE_SCOPE_GUARD_FWD(action)})) {
   static_assert(std::is_rvalue_reference<F&&>::value, "make_scope_fail requires an rvalue action; use std::move or pass a temporary.");
-  return scope_fail<F>{NEARGYE_SCOPE_GUARD_FWD(action)};
+  return scope_fail<F, T>{NEARGYE_SCOPE_GUARD_FWD(action)};
 }
 
-template <typename F>
-using scope_success = scope_guard<F, on_success_policy>;
+template <typename T = default_throw_action, typename... F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTIONS(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR scope_group<on_fail_policy, T, F...> make_scope_fail(F&&... actions) noexcept(noexcept(scope_group<on_fail_policy, T, F...>{action_group<T, typename std::decay<F>::type...>{NEARGYE_SCOPE_GUARD_FWD(actions)...}})) {
+  static_assert(all_of<std::is_rvalue_reference<F&&>::value...>::value, "make_scope_fail requires rvalue actions; use std::move or pass temporaries.");
+  return scope_group<on_fail_policy, T, F...>{action_group<T, typename std::decay<F>::type...>{NEARGYE_SCOPE_GUARD_FWD(actions)...}};
+}
 
-template <typename F, typename std::enable_if<is_noarg_returns_void_action<typename std::decay<F>::type&>::value, int>::type = 0>
-NEARGYE_SCOPE_GUARD_NODISCARD scope_success<F> make_scope_success(F&& action) noexcept(noexcept(scope_success<F>{NEARGYE_SCOPE_GUARD_FWD(action)})) {
+template <typename T = default_throw_action, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR scope_fail<F, T> make_scope_fail(const scope_fail_region& region, F&& action) noexcept(noexcept(scope_fail<F, T>{NEARGYE_SCOPE_GUARD_FWD(action), on_fail_policy{region}})) {
+  static_assert(std::is_rvalue_reference<F&&>::value, "make_scope_fail requires an rvalue action; use std::move or pass a temporary.");
+  return scope_fail<F, T>{NEARGYE_SCOPE_GUARD_FWD(action), on_fail_policy{region}};
+}
+
+template <typename F, typename T = default_throw_action>
+using scope_success = scope_guard<F, on_success_policy, T>;
+
+template <typename T = default_throw_action, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR scope_success<F, T> make_scope_success(F&& action) noexcept(noexcept(scope_success<F, T>{NEARGYE_SCOPE_GUARD_FWD(action)})) {
   static_assert(std::is_rvalue_reference<F&&>::value, "make_scope_success requires an rvalue action; use std::move or pass a temporary.");
-  return scope_success<F>{NEARGYE_SCOPE_GUARD_FWD(action)};
+  return scope_success<F, T>{NEARGYE_SCOPE_GUARD_FWD(action)};
+}
+
+template <typename T = default_throw_action, typename... F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTIONS(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR scope_group<on_success_policy, T, F...> make_scope_success(F&&... actions) noexcept(noexcept(scope_group<on_success_policy, T, F...>{action_group<T, typename std::decay<F>::type...>{NEARGYE_SCOPE_GUARD_FWD(actions)...}})) {
+  static_assert(all_of<std::is_rvalue_reference<F&&>::value...>::value, "make_scope_success requires rvalue actions; use std::move or pass temporaries.");
+  return scope_group<on_success_policy, T, F...>{action_group<T, typename std::decay<F>::type...>{NEARGYE_SCOPE_GUARD_FWD(actions)...}};
+}
+
+template <typename T = default_throw_action, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR scope_success<F, T> make_scope_success(const scope_fail_region& region, F&& action) noexcept(noexcept(scope_success<F, T>{NEARGYE_SCOPE_GUARD_FWD(action), on_success_policy{region}})) {
+  static_assert(std::is_rvalue_reference<F&&>::value, "make_scope_success requires an rvalue action; use std::move or pass a temporary.");
+  return scope_success<F, T>{NEARGYE_SCOPE_GUARD_FWD(action), on_success_policy{region}};
+}
+
+#if defined(NEARGYE_SCOPE_GUARD_PINNED_GUARDS)
+// Pinned guards can be neither moved nor dismissed. They are returned by guaranteed copy elision, so they need no move constructor,
+// and hold no dismissed state: pinned_scope_exit has no state besides the action, pinned_scope_fail/success only the exception baseline.
+template <typename F, typename T = default_throw_action>
+using pinned_scope_exit = scope_guard<F, on_exit_always_policy, T>;
+
+template <typename F, typename T = default_throw_action>
+using pinned_scope_fail = scope_guard<F, on_fail_pinned_policy, T>;
+
+template <typename F, typename T = default_throw_action>
+using pinned_scope_success = scope_guard<F, on_success_pinned_policy, T>;
+
+template <typename T = default_throw_action, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR pinned_scope_exit<F, T> make_pinned_scope_exit(F&& action) noexcept(noexcept(pinned_scope_exit<F, T>{scope_guard_construct_tag{}, NEARGYE_SCOPE_GUARD_FWD(action)})) {
+  static_assert(std::is_rvalue_reference<F&&>::value, "make_pinned_scope_exit requires an rvalue action; use std::move or pass a temporary.");
+  return {scope_guard_construct_tag{}, NEARGYE_SCOPE_GUARD_FWD(action)};
+}
+
+template <typename T = default_throw_action, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR pinned_scope_fail<F, T> make_pinned_scope_fail(F&& action) noexcept(noexcept(pinned_scope_fail<F, T>{scope_guard_construct_tag{}, NEARGYE_SCOPE_GUARD_FWD(action)})) {
+  static_assert(std::is_rvalue_reference<F&&>::value, "make_pinned_scope_fail requires an rvalue action; use std::move or pass a temporary.");
+  return {scope_guard_construct_tag{}, NEARGYE_SCOPE_GUARD_FWD(action)};
+}
+
+template <typename T = default_throw_action, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR pinned_scope_success<F, T> make_pinned_scope_success(F&& action) noexcept(noexcept(pinned_scope_success<F, T>{scope_guard_construct_tag{}, NEARGYE_SCOPE_GUARD_FWD(action)})) {
+  static_assert(std::is_rvalue_reference<F&&>::value, "make_pinned_scope_success requires an rvalue action; use std::move or pass a temporary.");
+  return {scope_guard_construct_tag{}, NEARGYE_SCOPE_GUARD_FWD(action)};
+}
+#endif
+
+template <typename F, typename S, typename T = default_throw_action>
+using scope_fail_on = scope_guard<F, on_status_fail_policy<S>, T>;
+
+template <typename T = default_throw_action, typename S, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR scope_fail_on<F, S, T> make_scope_fail_on(const S& status, F&& action) noexcept(noexcept(scope_fail_on<F, S, T>{NEARGYE_SCOPE_GUARD_FWD(action), on_status_fail_policy<S>{status}})) {
+  static_assert(std::is_rvalue_reference<F&&>::value, "make_scope_fail_on requires an rvalue action; use std::move or pass a temporary.");
+  return scope_fail_on<F, S, T>{NEARGYE_SCOPE_GUARD_FWD(action), on_status_fail_policy<S>{status}};
+}
+
+template <typename T = default_throw_action, typename S, typename F>
+void make_scope_fail_on(const S&& status, F&& action) = delete;
+
+template <typename F, typename S, typename T = default_throw_action>
+using scope_success_on = scope_guard<F, on_status_success_policy<S>, T>;
+
+template <typename T = default_throw_action, typename S, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR scope_success_on<F, S, T> make_scope_success_on(const S& status, F&& action) noexcept(noexcept(scope_success_on<F, S, T>{NEARGYE_SCOPE_GUARD_FWD(action), on_status_success_policy<S>{status}})) {
+  static_assert(std::is_rvalue_reference<F&&>::value, "make_scope_success_on requires an rvalue action; use std::move or pass a temporary.");
+  return scope_success_on<F, S, T>{NEARGYE_SCOPE_GUARD_FWD(action), on_status_success_policy<S>{status}};
+}
+
+template <typename T = default_throw_action, typename S, typename F>
+void make_scope_success_on(const S&& status, F&& action) = delete;
+
+template <typename F, typename T = default_throw_action>
+using scope_rollback = scope_guard<F, on_rollback_policy, T>;
+
+template <typename T = default_throw_action, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR scope_rollback<F, T> make_scope_rollback(const scope_transaction& transaction, F&& action) noexcept(noexcept(scope_rollback<F, T>{NEARGYE_SCOPE_GUARD_FWD(action), on_rollback_policy{transaction}})) {
+  static_assert(std::is_rvalue_reference<F&&>::value, "make_scope_rollback requires an rvalue action; use std::move or pass a temporary.");
+  return scope_rollback<F, T>{NEARGYE_SCOPE_GUARD_FWD(action), on_rollback_policy{transaction}};
+}
+
+template <typename T = default_throw_action, typename F>
+void make_scope_rollback(const scope_transaction&& transaction, F&& action) = delete;
+
+template <typename P, typename T = default_throw_action, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR scope_guard<F, P, T> make_scope_guard(F&& action) noexcept(noexcept(scope_guard<F, P, T>{scope_guard_construct_tag{}, NEARGYE_SCOPE_GUARD_FWD(action)})) {
+  static_assert(std::is_rvalue_reference<F&&>::value, "make_scope_guard requires an rvalue action; use std::move or pass a temporary.");
+  static_assert(std::is_constructible<P, bool>::value, "make_scope_guard requires policy constructible from bool; pass the policy object instead.");
+  return {scope_guard_construct_tag{}, NEARGYE_SCOPE_GUARD_FWD(action)};
+}
+
+template <typename T = default_throw_action, typename P, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_NODISCARD NEARGYE_SCOPE_GUARD_CONSTEXPR scope_guard<F, typename std::decay<P>::type, T> make_scope_guard(P&& policy, F&& action) noexcept(noexcept(scope_guard<F, typename std::decay<P>::type, T>{NEARGYE_SCOPE_GUARD_FWD(action), typename std::decay<P>::type(NEARGYE_SCOPE_GUARD_FWD(policy))})) {
+  static_assert(std::is_rvalue_reference<F&&>::value, "make_scope_guard requires an rvalue action; use std::move or pass a temporary.");
+  return {NEARGYE_SCOPE_GUARD_FWD(action), typename std::decay<P>::type(NEARGYE_SCOPE_GUARD_FWD(policy))};
+}
+
+template <typename T>
+struct default_is_trivially_relocatable
+    : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+template <typename F, typename P, typename T>
+struct default_is_trivially_relocatable<scope_guard<F, P, T>>
+    : std::integral_constant<bool, is_trivially_relocatable<typename std::decay<F>::type>::value && is_trivially_relocatable<P>::value> {};
+
+template <typename T, typename... A>
+struct default_is_trivially_relocatable<action_group<T, A...>>
+    : all_of<is_trivially_relocatable<A>::value...> {};
+
+template <typename T>
+T* relocate_at(T* source, T* destination, std::true_type) noexcept {
+  std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), sizeof(T));
+  return destination;
+}
+
+template <typename T>
+T* relocate_at(T* source, T* destination, std::false_type) noexcept(std::is_nothrow_move_constructible<T>::value) {
+  T* result = ::new (static_cast<void*>(destination)) T(NEARGYE_SCOPE_GUARD_MOV(*source));
+  source->~T();
+  return result;
+}
+
+// relocate_at moves the object at source into the uninitialized storage at destination and ends the lifetime of the source.
+// A trivially relocatable object is copied with memcpy, anything else is move constructed and the source is destroyed.
+template <typename T>
+T* relocate_at(T* source, T* destination) noexcept(is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value) {
+  return relocate_at(source, destination, is_trivially_relocatable<T>{});
+}
+
+template <typename T>
+T* uninitialized_relocate(T* first, T* last, T* result, std::true_type) noexcept {
+  if (first != last) {
+    std::memcpy(static_cast<void*>(result), static_cast<const void*>(first), static_cast<std::size_t>(last - first) * sizeof(T));
+  }
+  return result + (last - first);
+}
+
+template <typename T>
+T* uninitialized_relocate(T* first, T* last, T* result, std::false_type) noexcept {
+  for (; first != last; ++first, ++result) {
+    relocate_at(first, result, std::false_type{});
+  }
+  return result;
+}
+
+// uninitialized_relocate relocates [first, last) into the uninitialized, non-overlapping storage at result and returns the end of it.
+// Trivially relocatable objects are copied with one memcpy, e.g. when a buffer of guards grows.
+template <typename T>
+T* uninitialized_relocate(T* first, T* last, T* result) noexcept {
+  static_assert(is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value,
+                "uninitialized_relocate requires trivially relocatable or nothrow move constructible type.");
+  return uninitialized_relocate(first, last, result, is_trivially_relocatable<T>{});
 }
 
 struct scope_exit_tag {};
 
-template <typename F, typename std::enable_if<is_noarg_returns_void_action<typename std::decay<F>::type&>::value, int>::type = 0>
-scope_exit<F> operator<<(scope_exit_tag, F&& action) noexcept(noexcept(scope_exit<F>{NEARGYE_SCOPE_GUARD_FWD(action)})) {
+template <typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_CONSTEXPR scope_exit<F> operator<<(scope_exit_tag, F&& action) noexcept(noexcept(scope_exit<F>{NEARGYE_SCOPE_GUARD_FWD(action)})) {
   return scope_exit<F>{NEARGYE_SCOPE_GUARD_FWD(action)};
 }
 
+struct scope_defer_tag {};
+
+template <typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_CONSTEXPR scope_defer<F> operator<<(scope_defer_tag, F&& action) noexcept(noexcept(scope_defer<F>{scope_guard_construct_tag{}, NEARGYE_SCOPE_GUARD_FWD(action)})) {
+  return {scope_guard_construct_tag{}, NEARGYE_SCOPE_GUARD_FWD(action)};
+}
+
 struct scope_fail_tag {};
 
-template <typename F, typename std::enable_if<is_noarg_returns_void_action<typename std::decay<F>::type&>::value, int>::type = 0>
-scope_fail<F> operator<<(scope_fail_tag, F&& action) noexcept(noexcept(scope_fail<F>{NEARGYE_SCOPE_GUARD_FWD(action)})) {
+template <typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_CONSTEXPR scope_fail<F> operator<<(scope_fail_tag, F&& action) noexcept(noexcept(scope_fail<F>{NEARGYE_SCOPE_GUARD_FWD(action)})) {
   return scope_fail<F>{NEARGYE_SCOPE_GUARD_FWD(action)};
 }
 
 struct scope_success_tag {};
 
-template <typename F, typename std::enable_if<is_noarg_returns_void_action<typename std::decay<F>::type&>::value, int>::type = 0>
-scope_success<F> operator<<(scope_success_tag, F&& action) noexcept(noexcept(scope_success<F>{NEARGYE_SCOPE_GUARD_FWD(action)})) {
+template <typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_CONSTEXPR scope_success<F> operator<<(scope_success_tag, F&& action) noexcept(noexcept(scope_success<F>{NEARGYE_SCOPE_GUARD_FWD(action)})) {
   return scope_success<F>{NEARGYE_SCOPE_GUARD_FWD(action)};
 }
 
+NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_BEGIN
+
+struct scope_fail_region_tag {
+  const scope_fail_region& region;
+};
+
+template <typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_CONSTEXPR scope_fail<F> operator<<(scope_fail_region_tag tag, F&& action) noexcept(noexcept(scope_fail<F>{NEARGYE_SCOPE_GUARD_FWD(action), on_fail_policy{tag.region}})) {
+  return scope_fail<F>{NEARGYE_SCOPE_GUARD_FWD(action), on_fail_policy{tag.region}};
+}
+
+struct scope_success_region_tag {
+  const scope_fail_region& region;
+};
+
+template <typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_CONSTEXPR scope_success<F> operator<<(scope_success_region_tag tag, F&& action) noexcept(noexcept(scope_success<F>{NEARGYE_SCOPE_GUARD_FWD(action), on_success_policy{tag.region}})) {
+  return scope_success<F>{NEARGYE_SCOPE_GUARD_FWD(action), on_success_policy{tag.region}};
+}
+
+NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_END
+
+struct scope_rollback_tag {
+  const scope_transaction& transaction;
+};
+
+template <typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_CONSTEXPR scope_rollback<F> operator<<(scope_rollback_tag tag, F&& action) noexcept(noexcept(scope_rollback<F>{NEARGYE_SCOPE_GUARD_FWD(action), on_rollback_policy{tag.transaction}})) {
+  return scope_rollback<F>{NEARGYE_SCOPE_GUARD_FWD(action), on_rollback_policy{tag.transaction}};
+}
+
+template <typename S>
+struct scope_fail_on_tag {
+  const S& status;
+};
+
+template <typename S>
+NEARGYE_SCOPE_GUARD_CONSTEXPR scope_fail_on_tag<S> make_scope_fail_on_tag(const S& status) noexcept {
+  return {status};
+}
+
+template <typename S>
+void make_scope_fail_on_tag(const S&& status) = delete;
+
+template <typename S, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_CONSTEXPR scope_fail_on<F, S> operator<<(scope_fail_on_tag<S> tag, F&& action) noexcept(noexcept(scope_fail_on<F, S>{NEARGYE_SCOPE_GUARD_FWD(action), on_status_fail_policy<S>{tag.status}})) {
+  return scope_fail_on<F, S>{NEARGYE_SCOPE_GUARD_FWD(action), on_status_fail_policy<S>{tag.status}};
+}
+
+template <typename S>
+struct scope_success_on_tag {
+  const S& status;
+};
+
+template <typename S>
+NEARGYE_SCOPE_GUARD_CONSTEXPR scope_success_on_tag<S> make_scope_success_on_tag(const S& status) noexcept {
+  return {status};
+}
+
+template <typename S>
+void make_scope_success_on_tag(const S&& status) = delete;
+
+template <typename S, typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+NEARGYE_SCOPE_GUARD_CONSTEXPR scope_success_on<F, S> operator<<(scope_success_on_tag<S> tag, F&& action) noexcept(noexcept(scope_success_on<F, S>{NEARGYE_SCOPE_GUARD_FWD(action), on_status_success_policy<S>{tag.status}})) {
+  return scope_success_on<F, S>{NEARGYE_SCOPE_GUARD_FWD(action), on_status_success_policy<S>{tag.status}};
+}
+
+// destroy_on_exit destroys an object constructed in place, even if the action throws.
+template <typename U>
+struct destroy_on_exit {
+  U* object;
+
+  ~destroy_on_exit() {
+    object->~U();
+  }
+};
+
+// scope_stack_entry heads every action pushed to a basic_scope_stack, entries are linked LIFO across the inline buffer and spill chunks.
+struct scope_stack_entry {
+  scope_stack_entry* prev;
+  void (*run)(scope_stack_entry*, bool);
+};
+
+template <typename A, typename T>
+struct scope_stack_node : scope_stack_entry {
+  A action;
+
+  template <typename U>
+  scope_stack_node(scope_stack_entry* p, U&& a) noexcept(std::is_nothrow_constructible<A, U&&>::value)
+      : scope_stack_entry{p, &scope_stack_node::run},
+        action{NEARGYE_SCOPE_GUARD_FWD(a)} {}
+
+  static void run(scope_stack_entry* entry, bool execute) {
+    scope_stack_node* node = static_cast<scope_stack_node*>(entry);
+    destroy_on_exit<scope_stack_node> d{node};
+    if (execute) {
+      T::invoke(node->action);
+    }
+  }
+};
+
+// Spill chunk, its data follows the header.
+struct alignas(std::max_align_t) scope_stack_chunk {
+  scope_stack_chunk* prev;
+};
+
+template <typename P>
+struct is_success_policy
+    : std::false_type {};
+
+template <>
+struct is_success_policy<on_success_policy>
+    : std::true_type {};
+
+// basic_scope_stack holds a runtime number of heterogeneous actions contiguously in an inline buffer of N bytes,
+// spilling to geometrically growing chunks, and runs them in reverse order on scope exit if the policy says so.
+template <typename P, std::size_t N = 256, typename T = default_throw_action>
+class basic_scope_stack {
+  static_assert(N > 0, "basic_scope_stack requires non-empty inline buffer.");
+  static_assert(is_scope_guard_policy<P>::value && std::is_constructible<P, bool>::value,
+                "basic_scope_stack requires policy constructible from bool with bool should_execute() const noexcept.");
+  static_assert(is_throw_policy<T>::value,
+                "basic_scope_stack requires may_throw_action, no_throw_action or suppress_throw_action.");
+
+  // Continues with the remaining actions if an action throws.
+  struct continuation {
+    basic_scope_stack* stack;
+    bool execute;
+
+    ~continuation() {
+      if (stack->last_ != nullptr) {
+        stack->run_all(execute);
+      }
+    }
+  };
+
+  struct chunk_releaser {
+    scope_stack_chunk* chunks;
+
+    ~chunk_releaser() {
+      while (chunks != nullptr) {
+        scope_stack_chunk* prev = chunks->prev;
+        ::operator delete(chunks);
+        chunks = prev;
+      }
+    }
+  };
+
+  alignas(std::max_align_t) unsigned char buffer_[N];
+  unsigned char* top_;
+  unsigned char* end_;
+  scope_stack_entry* last_;
+  scope_stack_entry* dismissed_;
+  scope_stack_chunk* chunks_;
+  std::size_t next_capacity_;
+  std::size_t size_;
+  P policy_;
+
+  static unsigned char* align_up(unsigned char* p, std::size_t alignment) noexcept {
+    return p + ((alignment - reinterpret_cast<std::uintptr_t>(p) % alignment) % alignment);
+  }
+
+  // Returns aligned storage for size bytes, or nullptr if a spill chunk can not be allocated.
+  void* reserve(std::size_t size, std::size_t alignment) noexcept {
+    unsigned char* p = align_up(top_, alignment);
+    if (p <= end_ && static_cast<std::size_t>(end_ - p) >= size) {
+      return p;
+    }
+    std::size_t capacity = next_capacity_ < size ? size : next_capacity_;
+    void* memory = ::operator new(sizeof(scope_stack_chunk) + capacity, std::nothrow);
+    if (memory == nullptr) {
+      return nullptr;
+    }
+    scope_stack_chunk* chunk = ::new (memory) scope_stack_chunk{chunks_};
+    chunks_ = chunk;
+    top_ = reinterpret_cast<unsigned char*>(chunk + 1);
+    end_ = top_ + capacity;
+    next_capacity_ = capacity * 2;
+    return top_;
+  }
+
+  template <typename F>
+  void* reserve_node() noexcept {
+    using A = typename std::decay<F>::type;
+    using node = scope_stack_node<A, T>;
+    static_assert(std::is_rvalue_reference<F&&>::value, "basic_scope_stack::push requires an rvalue action; use std::move or pass a temporary.");
+    static_assert(alignof(node) <= alignof(std::max_align_t), "basic_scope_stack does not support over-aligned actions.");
+    static_assert(!std::is_same<T, no_throw_action>::value || is_nothrow_invocable_action<A&>::value,
+                  "scope_guard requires noexcept invocable action.");
+#if defined(SCOPE_GUARD_NO_THROW_CONSTRUCTIBLE)
+    static_assert(std::is_nothrow_move_constructible<A>::value,
+                  "scope_guard requires nothrow constructible action.");
+#endif
+    return reserve(sizeof(node), alignof(node));
+  }
+
+  // The action could not be pushed: like a guard that failed to construct, run it now unless it is a success action.
+  template <typename A>
+  void push_failed(A& action) {
+    if (!is_success_policy<P>::value) {
+      T::invoke(action);
+    }
+  }
+
+  [[noreturn]] static void throw_bad_alloc() {
+#if defined(NEARGYE_SCOPE_GUARD_NO_EXCEPTIONS)
+    std::abort();
+#else
+    throw std::bad_alloc{};
+#endif
+  }
+
+  void run_all(bool execute) {
+    continuation c{this, execute};
+    while (last_ != nullptr) {
+      scope_stack_entry* entry = last_;
+      last_ = entry->prev;
+      if (entry == dismissed_) {
+        c.execute = execute = false;
+      }
+      --size_;
+      entry->run(entry, execute);
+    }
+  }
+
+  void* operator new(std::size_t) = delete;
+  void operator delete(void*) = delete;
+
+ public:
+  basic_scope_stack() noexcept
+      : top_{buffer_},
+        end_{buffer_ + N},
+        last_{nullptr},
+        dismissed_{nullptr},
+        chunks_{nullptr},
+        next_capacity_{N * 2},
+        size_{0},
+        policy_{true} {}
+
+  basic_scope_stack(const basic_scope_stack&) = delete;
+  basic_scope_stack(basic_scope_stack&&) = delete;
+  basic_scope_stack& operator=(const basic_scope_stack&) = delete;
+  basic_scope_stack& operator=(basic_scope_stack&&) = delete;
+
+  // Pushes the action, it runs before every action pushed earlier.
+  // Like a guard whose construction fails, the cleanup is never lost: if the storage can not be allocated or the action
+  // can not be moved in, the action is run now as if the scope failed (except for scope_success_stack) and the exception
+  // (std::bad_alloc for the storage) is thrown. Use try_push to handle a failed allocation without running the action.
+  template <typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+  void push(F&& action) {
+    using node = scope_stack_node<typename std::decay<F>::type, T>;
+    void* p = reserve_node<F>();
+    if (p == nullptr) {
+      push_failed(action);
+      throw_bad_alloc();
+    }
+#if defined(NEARGYE_SCOPE_GUARD_NO_EXCEPTIONS)
+    last_ = ::new (p) node{last_, NEARGYE_SCOPE_GUARD_FWD(action)};
+#else
+    try {
+      last_ = ::new (p) node{last_, NEARGYE_SCOPE_GUARD_FWD(action)};
+    } catch (...) {
+      push_failed(action);
+      throw;
+    }
+#endif
+    top_ = static_cast<unsigned char*>(p) + sizeof(node);
+    ++size_;
+  }
+
+  // Pushes the action, or returns false if the storage can not be allocated. The action is then neither run nor moved
+  // from, the caller decides what to do with it.
+  template <typename F, NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION(F)>
+  NEARGYE_SCOPE_GUARD_NODISCARD bool try_push(F&& action) noexcept(std::is_nothrow_constructible<typename std::decay<F>::type, F&&>::value) {
+    using node = scope_stack_node<typename std::decay<F>::type, T>;
+    void* p = reserve_node<F>();
+    if (p == nullptr) {
+      return false;
+    }
+    last_ = ::new (p) node{last_, NEARGYE_SCOPE_GUARD_FWD(action)};
+    top_ = static_cast<unsigned char*>(p) + sizeof(node);
+    ++size_;
+    return true;
+  }
+
+  // Disables executing every action pushed so far, actions pushed later still run.
+  void dismiss_all() noexcept {
+    dismissed_ = last_;
+  }
+
+  std::size_t size() const noexcept {
+    return size_;
+  }
+
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  ~basic_scope_stack() noexcept(!std::is_same<T, may_throw_action>::value) {
+    chunk_releaser r{chunks_};
+    run_all(policy_.should_execute());
+  }
+};
+
+template <std::size_t N = 256, typename T = default_throw_action>
+using scope_exit_stack = basic_scope_stack<on_exit_policy, N, T>;
+
+template <std::size_t N = 256, typename T = default_throw_action>
+using scope_fail_stack = basic_scope_stack<on_fail_policy, N, T>;
+
+template <std::size_t N = 256, typename T = default_throw_action>
+using scope_success_stack = basic_scope_stack<on_success_policy, N, T>;
+
+enum class any_scope_op {
+  run,
+  destroy,
+  move
+};
+
+// any_scope_ops is the single dispatch function of a type-erased action stored in place.
+template <typename A, typename T>
+void any_scope_ops(any_scope_op op, void* self, void* other) {
+  A* action = static_cast<A*>(self);
+  switch (op) {
+    case any_scope_op::run: {
+      destroy_on_exit<A> d{action};
+      T::invoke(*action);
+      break;
+    }
+    case any_scope_op::destroy:
+      action->~A();
+      break;
+    case any_scope_op::move:
+      ::new (other) A(NEARGYE_SCOPE_GUARD_MOV(*action));
+      action->~A();
+      break;
+  }
+}
+
+// basic_any_scope type-erases the action into N bytes of inline storage, it never allocates.
+// Unlike scope_guard it is default constructible and move assignable, so it can be a class member.
+template <typename P, std::size_t N = 4 * sizeof(void*), typename T = default_throw_action>
+class basic_any_scope : private compressed_element<P, 0> {
+  using policy_storage = compressed_element<P, 0>;
+  using ops_type = void (*)(any_scope_op, void*, void*);
+
+  static_assert(N > 0, "basic_any_scope requires non-empty inline storage.");
+  static_assert(is_scope_guard_policy<P>::value && std::is_constructible<P, bool>::value,
+                "basic_any_scope requires policy constructible from bool with bool should_execute() const noexcept.");
+  static_assert(is_throw_policy<T>::value,
+                "basic_any_scope requires may_throw_action, no_throw_action or suppress_throw_action.");
+
+  alignas(std::max_align_t) unsigned char storage_[N];
+  ops_type ops_;
+
+  P& policy() noexcept {
+    return policy_storage::get();
+  }
+
+  void take(basic_any_scope& other) noexcept {
+    if (other.ops_ != nullptr) {
+      other.ops_(any_scope_op::move, other.storage_, storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  void finish() {
+    if (ops_ != nullptr) {
+      ops_type ops = ops_;
+      ops_ = nullptr;
+      ops(policy().should_execute() ? any_scope_op::run : any_scope_op::destroy, storage_, nullptr);
+    }
+  }
+
+ public:
+  basic_any_scope() noexcept : policy_storage{false}, ops_{nullptr} {}
+
+  basic_any_scope(const basic_any_scope&) = delete;
+  basic_any_scope& operator=(const basic_any_scope&) = delete;
+
+  basic_any_scope(basic_any_scope&& other) noexcept
+      : policy_storage{NEARGYE_SCOPE_GUARD_MOV(other.policy())},
+        ops_{nullptr} {
+    take(other);
+  }
+
+  template <typename F, typename std::enable_if<!std::is_same<typename std::decay<F>::type, basic_any_scope>::value && is_noarg_returns_void_action<typename std::decay<F>::type&>::value, int>::type = 0>
+  explicit basic_any_scope(F&& action) noexcept
+      : policy_storage{true},
+        ops_{&any_scope_ops<typename std::decay<F>::type, T>} {
+    using A = typename std::decay<F>::type;
+    static_assert(std::is_rvalue_reference<F&&>::value, "basic_any_scope requires an rvalue action; use std::move or pass a temporary.");
+    static_assert(sizeof(A) <= N, "basic_any_scope action does not fit into the inline storage, increase N.");
+    static_assert(alignof(A) <= alignof(std::max_align_t), "basic_any_scope does not support over-aligned actions.");
+    static_assert(std::is_nothrow_move_constructible<A>::value, "basic_any_scope requires nothrow move constructible action.");
+    static_assert(!std::is_same<T, no_throw_action>::value || is_nothrow_invocable_action<A&>::value,
+                  "scope_guard requires noexcept invocable action.");
+    ::new (static_cast<void*>(storage_)) A(NEARGYE_SCOPE_GUARD_FWD(action));
+  }
+
+  // Finishes the held action as if its scope ended, then takes the action of other.
+  basic_any_scope& operator=(basic_any_scope&& other) noexcept(!std::is_same<T, may_throw_action>::value) {
+    if (this != &other) {
+      finish();
+      policy() = NEARGYE_SCOPE_GUARD_MOV(other.policy());
+      take(other);
+    }
+    return *this;
+  }
+
+  // Disables executing the action and destroys it.
+  void dismiss() noexcept {
+    if (ops_ != nullptr) {
+      ops_(any_scope_op::destroy, storage_, nullptr);
+      ops_ = nullptr;
+    }
+  }
+
+  explicit operator bool() const noexcept {
+    return ops_ != nullptr;
+  }
+
+  ~basic_any_scope() noexcept(!std::is_same<T, may_throw_action>::value) {
+    finish();
+  }
+};
+
+template <std::size_t N = 4 * sizeof(void*), typename T = default_throw_action>
+using any_scope_exit = basic_any_scope<on_exit_always_policy, N, T>;
+
+template <std::size_t N = 4 * sizeof(void*), typename T = default_throw_action>
+using any_scope_fail = basic_any_scope<on_fail_policy, N, T>;
+
+template <std::size_t N = 4 * sizeof(void*), typename T = default_throw_action>
+using any_scope_success = basic_any_scope<on_success_policy, N, T>;
+
 #undef NEARGYE_SCOPE_GUARD_MOV
 #undef NEARGYE_SCOPE_GUARD_FWD
-#undef NEARGYE_SCOPE_GUARD_NOEXCEPT
-#undef NEARGYE_SCOPE_GUARD_TRY
-#undef NEARGYE_SCOPE_GUARD_CATCH
 #undef NEARGYE_SCOPE_GUARD_NODISCARD
+#undef NEARGYE_SCOPE_GUARD_NO_UNIQUE_ADDRESS
+#undef NEARGYE_SCOPE_GUARD_FORCE_INLINE
+#undef NEARGYE_SCOPE_GUARD_CONSTEXPR
+#undef NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTION
+#undef NEARGYE_SCOPE_GUARD_ENABLE_IF_ACTIONS
+#undef NEARGYE_SCOPE_GUARD_COLD
+#undef NEARGYE_SCOPE_GUARD_UNLIKELY
+#undef NEARGYE_SCOPE_GUARD_UNLIKELY_BRANCH
 
 } // namespace scope_guard::detail
 
 using detail::make_scope_exit;
 using detail::make_scope_fail;
 using detail::make_scope_success;
+using detail::make_scope_fail_on;
+using detail::make_scope_success_on;
+using detail::make_scope_guard;
+using detail::make_scope_rollback;
+using detail::scope_rollback;
+using detail::scope_transaction;
+using detail::scope_group;
+using detail::action_group;
+#if defined(NEARGYE_SCOPE_GUARD_PINNED_GUARDS)
+using detail::make_pinned_scope_exit;
+using detail::make_pinned_scope_fail;
+using detail::make_pinned_scope_success;
+using detail::pinned_scope_exit;
+using detail::pinned_scope_fail;
+using detail::pinned_scope_success;
+#endif
+using detail::is_scope_guard_policy;
+using detail::relocate_at;
+using detail::uninitialized_relocate;
+using detail::scope_fail_region;
+using detail::basic_scope_stack;
+using detail::scope_exit_stack;
+using detail::scope_fail_stack;
+using detail::scope_success_stack;
+using detail::basic_any_scope;
+using detail::any_scope_exit;
+using detail::any_scope_fail;
+using detail::any_scope_success;
+using detail::may_throw_action;
+using detail::no_throw_action;
+using detail::suppress_throw_action;
 
 } // namespace scope_guard
 
@@ -341,16 +1583,24 @@ using detail::make_scope_success;
 #endif
 
 #define NEARGYE_SCOPE_GUARD_MAKE_SCOPE_EXIT    ::scope_guard::detail::scope_exit_tag{}    << NEARGYE_SCOPE_GUARD_ACTION
+#define NEARGYE_SCOPE_GUARD_MAKE_SCOPE_DEFER   ::scope_guard::detail::scope_defer_tag{}   << NEARGYE_SCOPE_GUARD_ACTION
 #define NEARGYE_SCOPE_GUARD_MAKE_SCOPE_FAIL    ::scope_guard::detail::scope_fail_tag{}    << NEARGYE_SCOPE_GUARD_ACTION
 #define NEARGYE_SCOPE_GUARD_MAKE_SCOPE_SUCCESS ::scope_guard::detail::scope_success_tag{} << NEARGYE_SCOPE_GUARD_ACTION
 
-#define NEARGYE_SCOPE_GUARD_WITH_(g, i, j) for (bool i = true; i; i = false) for (auto j = g; i; i = false)
+#define NEARGYE_SCOPE_GUARD_MAKE_SCOPE_FAIL_IN(region)    ::scope_guard::detail::scope_fail_region_tag{region}    << NEARGYE_SCOPE_GUARD_ACTION
+#define NEARGYE_SCOPE_GUARD_MAKE_SCOPE_SUCCESS_IN(region) ::scope_guard::detail::scope_success_region_tag{region} << NEARGYE_SCOPE_GUARD_ACTION
+#define NEARGYE_SCOPE_GUARD_MAKE_SCOPE_FAIL_ON(status)    ::scope_guard::detail::make_scope_fail_on_tag(status)    << NEARGYE_SCOPE_GUARD_ACTION
+#define NEARGYE_SCOPE_GUARD_MAKE_SCOPE_SUCCESS_ON(status) ::scope_guard::detail::make_scope_success_on_tag(status) << NEARGYE_SCOPE_GUARD_ACTION
+#define NEARGYE_SCOPE_GUARD_MAKE_SCOPE_ROLLBACK(transaction) ::scope_guard::detail::scope_rollback_tag{transaction} << NEARGYE_SCOPE_GUARD_ACTION
+
+#define NEARGYE_SCOPE_GUARD_WITH_(g, i, j) for (bool i = true; i; i = false) for (auto&& j = g; i; i = false)
 #define NEARGYE_SCOPE_GUARD_WITH(g)        NEARGYE_SCOPE_GUARD_WITH_(g, NEARGYE_SCOPE_GUARD_STR_CONCAT(NEARGYE_SCOPE_GUARD_FLAG_, NEARGYE_SCOPE_GUARD_COUNTER), NEARGYE_SCOPE_GUARD_STR_CONCAT(NEARGYE_SCOPE_GUARD_OBJECT_, NEARGYE_SCOPE_GUARD_COUNTER))
 
 // SCOPE_EXIT executing action on scope exit.
+// SCOPE_EXIT and WITH_SCOPE_EXIT guards can not be dismissed, so they hold no execution flag and are bound to a reference without a move.
 #define MAKE_SCOPE_EXIT(name)  auto name = NEARGYE_SCOPE_GUARD_MAKE_SCOPE_EXIT
-#define SCOPE_EXIT             NEARGYE_SCOPE_GUARD_MAYBE_UNUSED const MAKE_SCOPE_EXIT(NEARGYE_SCOPE_GUARD_STR_CONCAT(NEARGYE_SCOPE_GUARD_SCOPE_EXIT_, NEARGYE_SCOPE_GUARD_COUNTER))
-#define WITH_SCOPE_EXIT(guard) NEARGYE_SCOPE_GUARD_WITH(NEARGYE_SCOPE_GUARD_MAKE_SCOPE_EXIT{ guard })
+#define SCOPE_EXIT             NEARGYE_SCOPE_GUARD_MAYBE_UNUSED const auto& NEARGYE_SCOPE_GUARD_STR_CONCAT(NEARGYE_SCOPE_GUARD_SCOPE_EXIT_, NEARGYE_SCOPE_GUARD_COUNTER) = NEARGYE_SCOPE_GUARD_MAKE_SCOPE_DEFER
+#define WITH_SCOPE_EXIT(guard) NEARGYE_SCOPE_GUARD_WITH(NEARGYE_SCOPE_GUARD_MAKE_SCOPE_DEFER{ guard })
 
 // SCOPE_FAIL executing action on scope exit when an exception has been thrown before scope exit.
 #define MAKE_SCOPE_FAIL(name)  auto name = NEARGYE_SCOPE_GUARD_MAKE_SCOPE_FAIL
@@ -362,6 +1612,23 @@ using detail::make_scope_success;
 #define SCOPE_SUCCESS             NEARGYE_SCOPE_GUARD_MAYBE_UNUSED const MAKE_SCOPE_SUCCESS(NEARGYE_SCOPE_GUARD_STR_CONCAT(NEARGYE_SCOPE_GUARD_SCOPE_SUCCESS_, NEARGYE_SCOPE_GUARD_COUNTER))
 #define WITH_SCOPE_SUCCESS(guard) NEARGYE_SCOPE_GUARD_WITH(NEARGYE_SCOPE_GUARD_MAKE_SCOPE_SUCCESS{ guard })
 
+// SCOPE_FAIL_IN/SCOPE_SUCCESS_IN same as SCOPE_FAIL/SCOPE_SUCCESS, but take the exception baseline from a scope_fail_region.
+#define MAKE_SCOPE_FAIL_IN(name, region)    auto name = NEARGYE_SCOPE_GUARD_MAKE_SCOPE_FAIL_IN(region)
+#define SCOPE_FAIL_IN(region)               NEARGYE_SCOPE_GUARD_MAYBE_UNUSED const MAKE_SCOPE_FAIL_IN(NEARGYE_SCOPE_GUARD_STR_CONCAT(NEARGYE_SCOPE_GUARD_SCOPE_FAIL_, NEARGYE_SCOPE_GUARD_COUNTER), region)
+#define MAKE_SCOPE_SUCCESS_IN(name, region) auto name = NEARGYE_SCOPE_GUARD_MAKE_SCOPE_SUCCESS_IN(region)
+#define SCOPE_SUCCESS_IN(region)            NEARGYE_SCOPE_GUARD_MAYBE_UNUSED const MAKE_SCOPE_SUCCESS_IN(NEARGYE_SCOPE_GUARD_STR_CONCAT(NEARGYE_SCOPE_GUARD_SCOPE_SUCCESS_, NEARGYE_SCOPE_GUARD_COUNTER), region)
+
+// SCOPE_FAIL_ON/SCOPE_SUCCESS_ON executing action on scope exit when the bound status reports failure/success.
+// Status is a bool success flag, an expected-like result (has_value()) or an error_code-like status (value() != 0 is failure).
+#define MAKE_SCOPE_FAIL_ON(name, status)    auto name = NEARGYE_SCOPE_GUARD_MAKE_SCOPE_FAIL_ON(status)
+#define SCOPE_FAIL_ON(status)               NEARGYE_SCOPE_GUARD_MAYBE_UNUSED const MAKE_SCOPE_FAIL_ON(NEARGYE_SCOPE_GUARD_STR_CONCAT(NEARGYE_SCOPE_GUARD_SCOPE_FAIL_, NEARGYE_SCOPE_GUARD_COUNTER), status)
+#define MAKE_SCOPE_SUCCESS_ON(name, status) auto name = NEARGYE_SCOPE_GUARD_MAKE_SCOPE_SUCCESS_ON(status)
+#define SCOPE_SUCCESS_ON(status)            NEARGYE_SCOPE_GUARD_MAYBE_UNUSED const MAKE_SCOPE_SUCCESS_ON(NEARGYE_SCOPE_GUARD_STR_CONCAT(NEARGYE_SCOPE_GUARD_SCOPE_SUCCESS_, NEARGYE_SCOPE_GUARD_COUNTER), status)
+
+// SCOPE_ROLLBACK executing action on scope exit unless the scope_transaction was committed.
+#define MAKE_SCOPE_ROLLBACK(name, transaction) auto name = NEARGYE_SCOPE_GUARD_MAKE_SCOPE_ROLLBACK(transaction)
+#define SCOPE_ROLLBACK(transaction)            NEARGYE_SCOPE_GUARD_MAYBE_UNUSED const MAKE_SCOPE_ROLLBACK(NEARGYE_SCOPE_GUARD_STR_CONCAT(NEARGYE_SCOPE_GUARD_SCOPE_ROLLBACK_, NEARGYE_SCOPE_GUARD_COUNTER), transaction)
+
 // DEFER executing action on scope exit.
 #define MAKE_DEFER(name)  MAKE_SCOPE_EXIT(name)
 #define DEFER             SCOPE_EXIT
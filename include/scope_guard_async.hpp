@@ -0,0 +1,419 @@
+//   _____                         _____                     _    _____
+//  / ____|                       / ____|                   | |  / ____|_     _
+// | (___   ___ ___  _ __   ___  | |  __ _   _  __ _ _ __ __| | | |   _| |_ _| |_
+//  \___ \ / __/ _ \| '_ \ / _ \ | | |_ | | | |/ _` | '__/ _` | | |  |_   _|_   _|
+//  ____) | (_| (_) | |_) |  __/ | |__| | |_| | (_| | | | (_| | | |____|_|   |_|
+// |_____/ \___\___/| .__/ \___|  \_____|\__,_|\__,_|_|  \__,_|  \_____|
+//                  | | https://github.com/Neargye/scope_guard
+//                  |_| version 0.9.4
+//
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018 - 2026 Daniil Goncharov <neargye@gmail.com>.
+//
+// Permission is hereby  granted, free of charge, to any  person obtaining a copy
+// of this software and associated  documentation files (the "Software"), to deal
+// in the Software  without restriction, including without  limitation the rights
+// to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+// copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+// IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+// FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+// AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+// LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef NEARGYE_SCOPE_GUARD_ASYNC_HPP
+#define NEARGYE_SCOPE_GUARD_ASYNC_HPP
+
+#include "scope_guard.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// scope_guard async settings:
+// SCOPE_GUARD_ASYNC_WORKERS number of worker threads of default_async_executor(), 1 by default.
+// SCOPE_GUARD_ASYNC_QUEUE_CAPACITY capacity of each worker queue of default_async_executor(), 1024 by default.
+// SCOPE_GUARD_ASYNC_ACTION_SIZE bytes of inline storage for a queued action, larger actions are allocated. 6 * sizeof(void*) by default.
+
+#if !defined(SCOPE_GUARD_ASYNC_WORKERS)
+#  define SCOPE_GUARD_ASYNC_WORKERS 1
+#endif
+
+#if !defined(SCOPE_GUARD_ASYNC_QUEUE_CAPACITY)
+#  define SCOPE_GUARD_ASYNC_QUEUE_CAPACITY 1024
+#endif
+
+#if !defined(SCOPE_GUARD_ASYNC_ACTION_SIZE)
+#  define SCOPE_GUARD_ASYNC_ACTION_SIZE (6 * sizeof(void*))
+#endif
+
+namespace scope_guard {
+
+namespace detail {
+
+// Actions run on a worker have no caller to propagate an exception to, so they are invoked with suppress_throw_action.
+template <typename A>
+void async_run_inline(void* storage) {
+  A* action = static_cast<A*>(storage);
+  destroy_on_exit<A> d{action};
+  suppress_throw_action::invoke(*action);
+}
+
+template <typename A>
+void async_run_allocated(void* storage) {
+  std::unique_ptr<A> action{*static_cast<A**>(storage)};
+  suppress_throw_action::invoke(*action);
+}
+
+template <typename A>
+struct is_async_inline_action
+    : std::integral_constant<bool, sizeof(A) <= SCOPE_GUARD_ASYNC_ACTION_SIZE && alignof(A) <= alignof(std::max_align_t)> {};
+
+struct async_cell {
+  std::atomic<std::size_t> sequence;
+  void (*run)(void*);
+  alignas(std::max_align_t) unsigned char storage[SCOPE_GUARD_ASYNC_ACTION_SIZE];
+};
+
+// async_queue_tail keeps the index claimed by producers on its own cache line, away from the consumer state.
+struct async_queue_tail {
+  unsigned char padding_before[64];
+  std::atomic<std::size_t> value;
+  unsigned char padding_after[64];
+};
+
+// async_queue is a bounded lock-free multi-producer single-consumer ring of actions.
+// Each cell carries a sequence number: pos when free for the producer of pos, pos + 1 when its action is published.
+class async_queue {
+  std::unique_ptr<async_cell[]> cells_;
+  std::size_t mask_;
+  async_queue_tail tail_;
+  std::size_t head_;
+  std::atomic<std::size_t> completed_;
+
+  static std::size_t round_up_capacity(std::size_t capacity) noexcept {
+    std::size_t result = 2;
+    while (result < capacity) {
+      result *= 2;
+    }
+    return result;
+  }
+
+ public:
+  explicit async_queue(std::size_t capacity)
+      : cells_{new async_cell[round_up_capacity(capacity)]},
+        mask_{round_up_capacity(capacity) - 1},
+        tail_{},
+        head_{0},
+        completed_{0} {
+    tail_.value.store(0, std::memory_order_relaxed);
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Moves the action into the queue, returns false if the queue is full.
+  template <typename A>
+  bool push(A& action, void (*run)(void*)) noexcept {
+    std::size_t pos = tail_.value.load(std::memory_order_relaxed);
+    async_cell* cell;
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      if (sequence == pos) {
+        if (tail_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (static_cast<std::ptrdiff_t>(sequence - pos) < 0) {
+        return false;
+      } else {
+        pos = tail_.value.load(std::memory_order_relaxed);
+      }
+    }
+    ::new (static_cast<void*>(cell->storage)) A(std::move(action));
+    cell->run = run;
+    cell->sequence.store(pos + 1, std::memory_order_seq_cst);
+    return true;
+  }
+
+  // Consumer only: the next action is published.
+  bool ready() const noexcept {
+    return cells_[head_ & mask_].sequence.load(std::memory_order_seq_cst) == head_ + 1;
+  }
+
+  // Consumer only: runs the next action, returns false if none is published.
+  bool run_one() noexcept {
+    async_cell& cell = cells_[head_ & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) != head_ + 1) {
+      return false;
+    }
+    cell.run(cell.storage);
+    cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+    ++head_;
+    completed_.store(head_, std::memory_order_release);
+    return true;
+  }
+
+  // Number of actions pushed so far, some of them may not be published yet.
+  std::size_t pushed() const noexcept {
+    return tail_.value.load(std::memory_order_acquire);
+  }
+
+  std::size_t completed() const noexcept {
+    return completed_.load(std::memory_order_acquire);
+  }
+};
+
+struct async_worker {
+  async_queue queue;
+  std::atomic<bool> sleeping;
+  std::atomic<int> flush_waiters;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable idle;
+  bool stop;
+  std::thread thread;
+
+  explicit async_worker(std::size_t capacity) : queue{capacity}, sleeping{false}, flush_waiters{0}, stop{false} {}
+
+  // Called by a producer after a push. The publishing store, this load and the sleeping store and ready() check in run()
+  // are sequentially consistent: either the producer sees the worker sleeping, or the worker sees the action before it blocks.
+  void notify() noexcept {
+    if (sleeping.load(std::memory_order_seq_cst)) {
+      std::lock_guard<std::mutex> lock{mutex};
+      wake.notify_one();
+    }
+  }
+
+  void run() noexcept {
+    for (;;) {
+      while (queue.run_one()) {
+        if (flush_waiters.load(std::memory_order_relaxed) != 0) {
+          std::lock_guard<std::mutex> lock{mutex};
+          idle.notify_all();
+        }
+      }
+      std::unique_lock<std::mutex> lock{mutex};
+      idle.notify_all();
+      sleeping.store(true, std::memory_order_seq_cst);
+      wake.wait(lock, [this]() { return stop || queue.ready(); });
+      sleeping.store(false, std::memory_order_relaxed);
+      if (stop && !queue.ready()) {
+        return;
+      }
+    }
+  }
+};
+
+// Home queue of the calling thread, producers start at different queues to spread contention.
+inline std::size_t async_thread_index() noexcept {
+  static std::atomic<std::size_t> next{0};
+  thread_local std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+// async_executor runs actions on a pool of background workers, each draining its own bounded lock-free queue.
+// If every queue is full (or there are no workers), the action runs inline on the calling thread.
+class async_executor {
+  std::vector<std::unique_ptr<async_worker>> workers_;
+  std::atomic<bool> closed_;
+
+  template <typename A>
+  bool push(A& action, void (*run)(void*)) noexcept {
+    const std::size_t size = workers_.size();
+    const std::size_t home = size == 0 ? 0 : async_thread_index() % size;
+    for (std::size_t i = 0; i < size; ++i) {
+      async_worker& worker = *workers_[(home + i) % size];
+      if (worker.queue.push(action, run)) {
+        worker.notify();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename A>
+  void submit(A& action, std::true_type) noexcept {
+    if (!push(action, &async_run_inline<A>)) {
+      suppress_throw_action::invoke(action);
+    }
+  }
+
+  template <typename A>
+  void submit(A& action, std::false_type) noexcept {
+    A* allocated = workers_.empty() ? nullptr : ::new (std::nothrow) A(std::move(action));
+    if (allocated == nullptr) {
+      suppress_throw_action::invoke(action);
+    } else if (!push(allocated, &async_run_allocated<A>)) {
+      std::unique_ptr<A> d{allocated};
+      suppress_throw_action::invoke(*allocated);
+    }
+  }
+
+  void shutdown() noexcept {
+    for (std::unique_ptr<async_worker>& worker : workers_) {
+      if (worker->thread.joinable()) {
+        {
+          std::lock_guard<std::mutex> lock{worker->mutex};
+          worker->stop = true;
+        }
+        worker->wake.notify_one();
+        worker->thread.join();
+      }
+    }
+  }
+
+ public:
+  // Starts workers threads, each with a queue of at least queue_capacity actions. With no workers every action runs inline.
+  explicit async_executor(std::size_t workers = SCOPE_GUARD_ASYNC_WORKERS, std::size_t queue_capacity = SCOPE_GUARD_ASYNC_QUEUE_CAPACITY) : closed_{false} {
+    workers_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+      workers_.emplace_back(new async_worker{queue_capacity});
+    }
+    auto stop_started = make_scope_fail([this]() { shutdown(); });
+    for (std::unique_ptr<async_worker>& worker : workers_) {
+      async_worker* w = worker.get();
+      w->thread = std::thread{[w]() { w->run(); }};
+    }
+  }
+
+  async_executor(const async_executor&) = delete;
+  async_executor& operator=(const async_executor&) = delete;
+
+  // Moves the action to a worker queue, or runs it inline if the queues are full. Never blocks.
+  template <typename F>
+  void submit(F&& action) noexcept {
+    using A = typename std::decay<F>::type;
+    static_assert(std::is_rvalue_reference<F&&>::value, "async_executor::submit requires an rvalue action; use std::move or pass a temporary.");
+    static_assert(is_noarg_returns_void_action<A&>::value, "async_executor requires no-argument action, that returns void.");
+    static_assert(std::is_nothrow_move_constructible<A>::value, "async_executor requires nothrow move constructible action.");
+    if (closed_.load(std::memory_order_seq_cst)) {
+      suppress_throw_action::invoke(action);
+      return;
+    }
+    submit(action, is_async_inline_action<A>{});
+  }
+
+  // Runs the actions submitted from now on inline, then waits for the queued ones. The workers keep running, so an
+  // action submitted concurrently with close() still runs, but may not be waited for.
+  void close() noexcept {
+    closed_.store(true, std::memory_order_seq_cst);
+    flush();
+  }
+
+  // Blocks until every action submitted before the call has run. Must not be called from an action run by this executor.
+  void flush() noexcept {
+    for (std::unique_ptr<async_worker>& worker : workers_) {
+      const std::size_t target = worker->queue.pushed();
+      worker->flush_waiters.fetch_add(1);
+      {
+        std::unique_lock<std::mutex> lock{worker->mutex};
+        worker->idle.wait(lock, [&worker, target]() { return worker->queue.completed() >= target; });
+      }
+      worker->flush_waiters.fetch_sub(1);
+    }
+  }
+
+  std::size_t workers() const noexcept {
+    return workers_.size();
+  }
+
+  // Runs the queued actions and stops the workers.
+  ~async_executor() {
+    flush();
+    shutdown();
+  }
+};
+
+inline async_executor& default_async_executor();
+
+inline void close_default_async_executor() noexcept {
+  default_async_executor().close();
+}
+
+// default_async_executor is used by DEFER_ASYNC and make_scope_exit_async without an executor. It is never destroyed,
+// so guards in static destructors and in threads still running at exit can use it: it is closed by std::atexit,
+// after which their actions run inline.
+inline async_executor& default_async_executor() {
+  static async_executor* const executor = new async_executor{SCOPE_GUARD_ASYNC_WORKERS, SCOPE_GUARD_ASYNC_QUEUE_CAPACITY};
+  static const int close_at_exit = std::atexit(&close_default_async_executor);
+  static_cast<void>(close_at_exit);
+  return *executor;
+}
+
+// async_action is the action of an asynchronous guard: invoking it submits the wrapped action to the executor.
+template <typename A>
+class async_action {
+  static_assert(std::is_nothrow_move_constructible<A>::value,
+                "scope_exit_async requires nothrow move constructible action.");
+
+  async_executor* executor_;
+  A action_;
+
+ public:
+  async_action(async_executor& executor, A&& action) noexcept
+      : executor_{&executor},
+        action_{std::move(action)} {}
+
+  void operator()() noexcept {
+    executor_->submit(std::move(action_));
+  }
+};
+
+template <typename F>
+using scope_exit_async = scope_guard<async_action<typename std::decay<F>::type>, on_exit_policy, no_throw_action>;
+
+template <typename F, typename std::enable_if<is_noarg_returns_void_action<typename std::decay<F>::type&>::value, int>::type = 0>
+scope_exit_async<F> make_scope_exit_async(async_executor& executor, F&& action) noexcept {
+  static_assert(std::is_rvalue_reference<F&&>::value, "make_scope_exit_async requires an rvalue action; use std::move or pass a temporary.");
+  return scope_exit_async<F>{async_action<typename std::decay<F>::type>{executor, std::move(action)}};
+}
+
+template <typename F, typename std::enable_if<is_noarg_returns_void_action<typename std::decay<F>::type&>::value, int>::type = 0>
+scope_exit_async<F> make_scope_exit_async(F&& action) {
+  static_assert(std::is_rvalue_reference<F&&>::value, "make_scope_exit_async requires an rvalue action; use std::move or pass a temporary.");
+  return scope_exit_async<F>{async_action<typename std::decay<F>::type>{default_async_executor(), std::move(action)}};
+}
+
+struct scope_defer_async_tag {
+  async_executor& executor;
+};
+
+template <typename F, typename std::enable_if<is_noarg_returns_void_action<typename std::decay<F>::type&>::value, int>::type = 0>
+scope_guard<async_action<typename std::decay<F>::type>, on_exit_always_policy, no_throw_action> operator<<(scope_defer_async_tag tag, F&& action) noexcept {
+  return {scope_guard_construct_tag{}, async_action<typename std::decay<F>::type>{tag.executor, std::move(action)}};
+}
+
+} // namespace scope_guard::detail
+
+using detail::async_executor;
+using detail::default_async_executor;
+using detail::scope_exit_async;
+using detail::make_scope_exit_async;
+
+} // namespace scope_guard
+
+// DEFER_ASYNC executing action on scope exit on a worker of default_async_executor(), or inline if its queues are full.
+// The action captures by copy ([=]), as it may run after the scope is left.
+#define NEARGYE_SCOPE_GUARD_MAKE_DEFER_ASYNC(executor) ::scope_guard::detail::scope_defer_async_tag{executor} << [=]() -> void
+#define DEFER_ASYNC_ON(executor) NEARGYE_SCOPE_GUARD_MAYBE_UNUSED const auto& NEARGYE_SCOPE_GUARD_STR_CONCAT(NEARGYE_SCOPE_GUARD_DEFER_ASYNC_, NEARGYE_SCOPE_GUARD_COUNTER) = NEARGYE_SCOPE_GUARD_MAKE_DEFER_ASYNC(executor)
+#define DEFER_ASYNC              DEFER_ASYNC_ON(::scope_guard::default_async_executor())
+
+#endif // NEARGYE_SCOPE_GUARD_ASYNC_HPP
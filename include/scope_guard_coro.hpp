@@ -0,0 +1,651 @@
+//   _____                         _____                     _    _____
+//  / ____|                       / ____|                   | |  / ____|_     _
+// | (___   ___ ___  _ __   ___  | |  __ _   _  __ _ _ __ __| | | |   _| |_ _| |_
+//  \___ \ / __/ _ \| '_ \ / _ \ | | |_ | | | |/ _` | '__/ _` | | |  |_   _|_   _|
+//  ____) | (_| (_) | |_) |  __/ | |__| | |_| | (_| | | | (_| | | |____|_|   |_|
+// |_____/ \___\___/| .__/ \___|  \_____|\__,_|\__,_|_|  \__,_|  \_____|
+//                  | | https://github.com/Neargye/scope_guard
+//                  |_| version 0.9.4
+//
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018 - 2026 Daniil Goncharov <neargye@gmail.com>.
+//
+// Permission is hereby  granted, free of charge, to any  person obtaining a copy
+// of this software and associated  documentation files (the "Software"), to deal
+// in the Software  without restriction, including without  limitation the rights
+// to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+// copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+// IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+// FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+// AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+// LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef NEARGYE_SCOPE_GUARD_CORO_HPP
+#define NEARGYE_SCOPE_GUARD_CORO_HPP
+
+#include "scope_guard.hpp"
+
+#if defined(__has_include)
+#  if __has_include(<coroutine>) && defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#    define NEARGYE_SCOPE_GUARD_COROUTINES
+#  endif
+#endif
+
+#if defined(NEARGYE_SCOPE_GUARD_COROUTINES)
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace scope_guard {
+
+NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_BEGIN
+
+template <typename T = void>
+class task;
+
+NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_END
+
+namespace detail {
+
+NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_BEGIN
+
+enum class co_scope_kind { exit, fail, success, dismissed };
+
+// co_cleanup_node heads every cleanup registered with co_scope_exit/co_scope_fail/co_scope_success, nodes are linked LIFO in the promise.
+struct co_cleanup_node {
+  co_cleanup_node* next;
+  co_scope_kind kind;
+  task<void> (*run)(co_cleanup_node*);
+  void (*destroy)(co_cleanup_node*) noexcept;
+};
+
+class task_promise_base;
+
+inline task<void> run_co_cleanups(task_promise_base& promise);
+
+// task_resumption tracks the uncaught exceptions on the thread that resumed the task last. Between two suspensions
+// the body runs on one thread, so the count only grows past the baseline while an exception leaves the body.
+class task_resumption {
+  int ec_ = 0;
+  unsigned int generation_ = 0;
+
+ public:
+  void resumed() noexcept {
+    ec_ = uncaught_exceptions();
+    ++generation_;
+  }
+
+  unsigned int generation() const noexcept {
+    return generation_;
+  }
+
+  // A guard created since the last resumption keeps its own baseline, as it may have been created during unwinding.
+  int baseline(int ec, unsigned int generation) const noexcept {
+    return generation == generation_ ? ec : ec_;
+  }
+};
+
+// on_task_fail_policy/on_task_success_policy compare the uncaught exceptions with the baseline of the current resumption
+// of the task, instead of the count on the thread that created the guard.
+class on_task_fail_policy {
+  const task_resumption* resumption_;
+  int ec_;
+  unsigned int generation_;
+
+ public:
+  explicit on_task_fail_policy(const task_resumption& resumption) noexcept
+      : resumption_{&resumption},
+        ec_{uncaught_exceptions()},
+        generation_{resumption.generation()} {}
+
+  void dismiss() noexcept {
+    resumption_ = nullptr;
+  }
+
+  bool should_execute() const noexcept {
+    return resumption_ != nullptr && resumption_->baseline(ec_, generation_) < uncaught_exceptions();
+  }
+};
+
+class on_task_success_policy {
+  const task_resumption* resumption_;
+  int ec_;
+  unsigned int generation_;
+
+ public:
+  explicit on_task_success_policy(const task_resumption& resumption) noexcept
+      : resumption_{&resumption},
+        ec_{uncaught_exceptions()},
+        generation_{resumption.generation()} {}
+
+  void dismiss() noexcept {
+    resumption_ = nullptr;
+  }
+
+  bool should_execute() const noexcept {
+    return resumption_ != nullptr && resumption_->baseline(ec_, generation_) >= uncaught_exceptions();
+  }
+};
+
+template <typename A>
+decltype(auto) get_awaiter(A&& awaitable) {
+  if constexpr (requires { std::forward<A>(awaitable).operator co_await(); }) {
+    return std::forward<A>(awaitable).operator co_await();
+  } else if constexpr (requires { operator co_await(std::forward<A>(awaitable)); }) {
+    return operator co_await(std::forward<A>(awaitable));
+  } else {
+    return std::forward<A>(awaitable);
+  }
+}
+
+// task_resume_awaiter wraps every awaiter in a task body to record the resumption before the body continues.
+// A is an awaiter type, or a reference to the awaitable, which lives until the end of the co_await expression.
+template <typename A>
+class task_resume_awaiter {
+  A awaiter_;
+  task_resumption* resumption_;
+
+ public:
+  task_resume_awaiter(A&& awaiter, task_resumption& resumption) noexcept(std::is_nothrow_constructible_v<A, A&&>)
+      : awaiter_{std::forward<A>(awaiter)},
+        resumption_{&resumption} {}
+
+  bool await_ready() noexcept(noexcept(awaiter_.await_ready())) {
+    return awaiter_.await_ready();
+  }
+
+  template <typename P>
+  decltype(auto) await_suspend(std::coroutine_handle<P> handle) noexcept(noexcept(awaiter_.await_suspend(handle))) {
+    return awaiter_.await_suspend(handle);
+  }
+
+  decltype(auto) await_resume() noexcept(noexcept(awaiter_.await_resume())) {
+    resumption_->resumed();
+    return awaiter_.await_resume();
+  }
+};
+
+// task_promise_base holds the state shared by every task promise: the awaiting coroutine, the exception that left the body
+// and the registered cleanups. When the body completes, the cleanups are awaited in reverse order by a driver coroutine
+// before the awaiting coroutine is resumed.
+class task_promise_base {
+  friend task<void> run_co_cleanups(task_promise_base& promise);
+
+  std::coroutine_handle<> continuation_ = std::noop_coroutine();
+  co_cleanup_node* cleanups_ = nullptr;
+  std::coroutine_handle<> cleanup_driver_ = nullptr;
+  task_resumption resumption_;
+
+ protected:
+  std::exception_ptr exception_ = nullptr;
+
+  void rethrow_if_failed() const {
+    if (exception_ != nullptr) {
+      std::rethrow_exception(exception_);
+    }
+  }
+
+ public:
+  struct final_awaiter {
+    bool await_ready() const noexcept {
+      return false;
+    }
+
+    template <typename P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept {
+      return handle.promise().completed();
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  task_promise_base() noexcept = default;
+  task_promise_base(const task_promise_base&) = delete;
+  task_promise_base& operator=(const task_promise_base&) = delete;
+
+  task_resume_awaiter<std::suspend_always> initial_suspend() noexcept {
+    return {std::suspend_always{}, resumption_};
+  }
+
+  final_awaiter final_suspend() const noexcept {
+    return {};
+  }
+
+  template <typename A>
+  task_resume_awaiter<decltype(get_awaiter(std::declval<A>()))> await_transform(A&& awaitable) noexcept(noexcept(task_resume_awaiter<decltype(get_awaiter(std::declval<A>()))>{get_awaiter(std::forward<A>(awaitable)), resumption_})) {
+    return {get_awaiter(std::forward<A>(awaitable)), resumption_};
+  }
+
+  const task_resumption& resumption() const noexcept {
+    return resumption_;
+  }
+
+  void unhandled_exception() noexcept {
+    exception_ = std::current_exception();
+  }
+
+  void set_continuation(std::coroutine_handle<> continuation) noexcept {
+    continuation_ = continuation;
+  }
+
+  void push_cleanup(co_cleanup_node* node) noexcept {
+    node->next = cleanups_;
+    cleanups_ = node;
+  }
+
+  // The body has completed: returns the coroutine to resume, the cleanup driver if there are cleanups.
+  std::coroutine_handle<> completed() noexcept;
+
+  ~task_promise_base() {
+    while (cleanups_ != nullptr) {
+      co_cleanup_node* node = cleanups_;
+      cleanups_ = node->next;
+      node->destroy(node);
+    }
+    if (cleanup_driver_) {
+      cleanup_driver_.destroy();
+    }
+  }
+};
+
+template <typename T>
+class task_promise : public task_promise_base {
+  std::optional<T> value_;
+
+ public:
+  task<T> get_return_object() noexcept;
+
+  template <typename U>
+  void return_value(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>) {
+    value_.emplace(std::forward<U>(value));
+  }
+
+  T result() {
+    rethrow_if_failed();
+    return std::move(*value_);
+  }
+};
+
+template <>
+class task_promise<void> : public task_promise_base {
+ public:
+  task<void> get_return_object() noexcept;
+
+  void return_void() const noexcept {}
+
+  void result() const {
+    rethrow_if_failed();
+  }
+};
+
+NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_END
+
+} // namespace scope_guard::detail
+
+NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_BEGIN
+
+// task is a lazily started coroutine, awaited with co_await or run to completion with sync_wait.
+// Its promise runs the cleanups registered by co_scope_exit/co_scope_fail/co_scope_success before the awaiting coroutine resumes.
+template <typename T>
+class task {
+ public:
+  using promise_type = detail::task_promise<T>;
+
+ private:
+  std::coroutine_handle<promise_type> handle_;
+
+  struct awaiter {
+    std::coroutine_handle<promise_type> handle;
+
+    bool await_ready() const noexcept {
+      return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept {
+      handle.promise().set_continuation(continuation);
+      return handle;
+    }
+
+    T await_resume() {
+      return handle.promise().result();
+    }
+  };
+
+ public:
+  explicit task(std::coroutine_handle<promise_type> handle) noexcept : handle_{handle} {}
+
+  task(task&& other) noexcept : handle_{std::exchange(other.handle_, nullptr)} {}
+
+  task(const task&) = delete;
+  task& operator=(const task&) = delete;
+  task& operator=(task&&) = delete;
+
+  awaiter operator co_await() && noexcept {
+    return awaiter{handle_};
+  }
+
+  awaiter operator co_await() & noexcept {
+    return awaiter{handle_};
+  }
+
+  ~task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  friend std::coroutine_handle<> detail::task_promise_base::completed() noexcept;
+  friend task<void> detail::run_co_cleanups(detail::task_promise_base& promise);
+
+ private:
+  std::coroutine_handle<promise_type> release() noexcept {
+    return std::exchange(handle_, nullptr);
+  }
+};
+
+NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_END
+
+namespace detail {
+
+NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_BEGIN
+
+template <typename T>
+task<T> task_promise<T>::get_return_object() noexcept {
+  return task<T>{std::coroutine_handle<task_promise<T>>::from_promise(*this)};
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept {
+  return task<void>{std::coroutine_handle<task_promise<void>>::from_promise(*this)};
+}
+
+// A cleanup action returns an awaitable (e.g. a task<void>), or void for a synchronous cleanup.
+template <typename F>
+task<void> invoke_cleanup(F& action) {
+  if constexpr (std::is_void_v<decltype(action())>) {
+    action();
+  } else {
+    co_await action();
+  }
+  co_return;
+}
+
+template <typename F>
+struct co_cleanup : co_cleanup_node {
+  F action;
+
+  co_cleanup(co_scope_kind k, F&& a) noexcept(std::is_nothrow_move_constructible_v<F>)
+      : co_cleanup_node{nullptr, k, &co_cleanup::run_action, &co_cleanup::destroy_action},
+        action{std::move(a)} {}
+
+  static task<void> run_action(co_cleanup_node* node) {
+    return invoke_cleanup(static_cast<co_cleanup*>(node)->action);
+  }
+
+  static void destroy_action(co_cleanup_node* node) noexcept {
+    delete static_cast<co_cleanup*>(node);
+  }
+};
+
+// destroy_co_cleanup_on_exit frees a cleanup after it was awaited, or when the driver frame is destroyed.
+struct destroy_co_cleanup_on_exit {
+  co_cleanup_node* node;
+
+  ~destroy_co_cleanup_on_exit() {
+    node->destroy(node);
+  }
+};
+
+// Awaits the cleanups in reverse order. Exit/fail/success is decided once from the exception that left the body,
+// every cleanup is awaited even if one throws, and the first exception is kept.
+inline task<void> run_co_cleanups(task_promise_base& promise) {
+  const bool failed = promise.exception_ != nullptr;
+  while (promise.cleanups_ != nullptr) {
+    co_cleanup_node* node = promise.cleanups_;
+    promise.cleanups_ = node->next;
+    destroy_co_cleanup_on_exit d{node};
+    if (node->kind == co_scope_kind::exit || (node->kind == co_scope_kind::fail && failed) || (node->kind == co_scope_kind::success && !failed)) {
+      try {
+        co_await node->run(node);
+      } catch (...) {
+        if (promise.exception_ == nullptr) {
+          promise.exception_ = std::current_exception();
+        }
+      }
+    }
+  }
+}
+
+inline std::coroutine_handle<> task_promise_base::completed() noexcept {
+  if (cleanups_ == nullptr) {
+    return continuation_;
+  }
+  std::coroutine_handle<task_promise<void>> driver = run_co_cleanups(*this).release();
+  driver.promise().set_continuation(continuation_);
+  cleanup_driver_ = driver;
+  return driver;
+}
+
+// co_scope_handle refers to a registered cleanup until the body completes.
+class co_scope_handle {
+  co_cleanup_node* node_;
+
+ public:
+  explicit co_scope_handle(co_cleanup_node* node) noexcept : node_{node} {}
+
+  void dismiss() noexcept {
+    node_->kind = co_scope_kind::dismissed;
+  }
+};
+
+// co_scope_awaiter registers the cleanup in the promise of the awaiting task without suspending it.
+template <typename F>
+class co_scope_awaiter {
+  co_scope_kind kind_;
+  F action_;
+  co_cleanup_node* node_ = nullptr;
+
+ public:
+  co_scope_awaiter(co_scope_kind kind, F&& action) noexcept(std::is_nothrow_move_constructible_v<F>)
+      : kind_{kind},
+        action_{std::move(action)} {}
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  template <typename P>
+  bool await_suspend(std::coroutine_handle<P> handle) {
+    static_assert(std::is_base_of_v<task_promise_base, P>, "co_scope_exit/co_scope_fail/co_scope_success require a scope_guard::task coroutine.");
+    node_ = new co_cleanup<F>{kind_, std::move(action_)};
+    handle.promise().push_cleanup(node_);
+    return false;
+  }
+
+  co_scope_handle await_resume() const noexcept {
+    return co_scope_handle{node_};
+  }
+};
+
+template <typename F>
+concept co_cleanup_action = std::is_invocable_v<std::decay_t<F>&>;
+
+// task_guard_awaiter binds a guard to the resumption state of the awaiting task without suspending it.
+template <typename G, typename P, typename A>
+class task_guard_awaiter {
+  A action_;
+  const task_resumption* resumption_ = nullptr;
+
+ public:
+  explicit task_guard_awaiter(A&& action) noexcept(std::is_nothrow_move_constructible_v<A>) : action_{std::move(action)} {}
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  template <typename Q>
+  bool await_suspend(std::coroutine_handle<Q> handle) noexcept {
+    static_assert(std::is_base_of_v<task_promise_base, Q>, "make_task_scope_fail/make_task_scope_success require a scope_guard::task coroutine.");
+    resumption_ = &handle.promise().resumption();
+    return false;
+  }
+
+  G await_resume() noexcept(std::is_nothrow_move_constructible_v<A>) {
+    return G{std::move(action_), P{*resumption_}};
+  }
+};
+
+struct sync_wait_state {
+  std::mutex mutex;
+  std::condition_variable done_cv;
+  bool done = false;
+};
+
+// sync_wait_task signals the waiting thread when the awaited task has completed, on whichever thread resumed it last.
+struct sync_wait_task {
+  struct promise_type {
+    sync_wait_state* state = nullptr;
+
+    sync_wait_task get_return_object() noexcept {
+      return sync_wait_task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    std::suspend_always initial_suspend() const noexcept {
+      return {};
+    }
+
+    auto final_suspend() const noexcept {
+      struct awaiter {
+        bool await_ready() const noexcept {
+          return false;
+        }
+
+        void await_suspend(std::coroutine_handle<promise_type> handle) const noexcept {
+          sync_wait_state& s = *handle.promise().state;
+          std::lock_guard<std::mutex> lock{s.mutex};
+          s.done = true;
+          s.done_cv.notify_all();
+        }
+
+        void await_resume() const noexcept {}
+      };
+      return awaiter{};
+    }
+
+    void return_void() const noexcept {}
+
+    void unhandled_exception() const noexcept {
+      std::terminate();
+    }
+  };
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+template <typename T, typename R>
+sync_wait_task sync_wait_body(task<T>& awaited, std::optional<R>& result, std::exception_ptr& exception) {
+  try {
+    if constexpr (std::is_void_v<T>) {
+      co_await awaited;
+      result.emplace();
+    } else {
+      result.emplace(co_await awaited);
+    }
+  } catch (...) {
+    exception = std::current_exception();
+  }
+}
+
+NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_END
+
+} // namespace scope_guard::detail
+
+NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_BEGIN
+
+// co_await co_scope_exit(action) registers an asynchronous cleanup in the current task: when the body completes, the
+// awaitable returned by action() is awaited before the task completes. co_scope_fail/co_scope_success await it only if
+// the body exits with/without an exception. Cleanups run in reverse order of registration, after the locals of the
+// body are destroyed, so the action must own its state (capture by value) or refer to the coroutine parameters.
+template <typename F> requires detail::co_cleanup_action<F>
+detail::co_scope_awaiter<std::decay_t<F>> co_scope_exit(F&& action) noexcept(std::is_nothrow_move_constructible_v<std::decay_t<F>>) {
+  static_assert(std::is_rvalue_reference_v<F&&>, "co_scope_exit requires an rvalue action; use std::move or pass a temporary.");
+  return {detail::co_scope_kind::exit, std::move(action)};
+}
+
+template <typename F> requires detail::co_cleanup_action<F>
+detail::co_scope_awaiter<std::decay_t<F>> co_scope_fail(F&& action) noexcept(std::is_nothrow_move_constructible_v<std::decay_t<F>>) {
+  static_assert(std::is_rvalue_reference_v<F&&>, "co_scope_fail requires an rvalue action; use std::move or pass a temporary.");
+  return {detail::co_scope_kind::fail, std::move(action)};
+}
+
+template <typename F> requires detail::co_cleanup_action<F>
+detail::co_scope_awaiter<std::decay_t<F>> co_scope_success(F&& action) noexcept(std::is_nothrow_move_constructible_v<std::decay_t<F>>) {
+  static_assert(std::is_rvalue_reference_v<F&&>, "co_scope_success requires an rvalue action; use std::move or pass a temporary.");
+  return {detail::co_scope_kind::success, std::move(action)};
+}
+
+template <typename F, typename T = detail::default_throw_action>
+using task_scope_fail = detail::scope_guard<F, detail::on_task_fail_policy, T>;
+
+template <typename F, typename T = detail::default_throw_action>
+using task_scope_success = detail::scope_guard<F, detail::on_task_success_policy, T>;
+
+// co_await make_task_scope_fail(action) returns a scope_fail guard bound to the current task. A coroutine may be resumed
+// on another thread, whose uncaught exceptions differ from the thread that created the guard, so the guard compares
+// with the count recorded when the task was resumed last. Like scope_fail, the action runs when the guard is destroyed.
+template <typename T = detail::default_throw_action, typename F> requires detail::is_noarg_returns_void_action<std::decay_t<F>&>::value
+detail::task_guard_awaiter<task_scope_fail<std::decay_t<F>, T>, detail::on_task_fail_policy, std::decay_t<F>> make_task_scope_fail(F&& action) noexcept(std::is_nothrow_move_constructible_v<std::decay_t<F>>) {
+  static_assert(std::is_rvalue_reference_v<F&&>, "make_task_scope_fail requires an rvalue action; use std::move or pass a temporary.");
+  return detail::task_guard_awaiter<task_scope_fail<std::decay_t<F>, T>, detail::on_task_fail_policy, std::decay_t<F>>{std::move(action)};
+}
+
+template <typename T = detail::default_throw_action, typename F> requires detail::is_noarg_returns_void_action<std::decay_t<F>&>::value
+detail::task_guard_awaiter<task_scope_success<std::decay_t<F>, T>, detail::on_task_success_policy, std::decay_t<F>> make_task_scope_success(F&& action) noexcept(std::is_nothrow_move_constructible_v<std::decay_t<F>>) {
+  static_assert(std::is_rvalue_reference_v<F&&>, "make_task_scope_success requires an rvalue action; use std::move or pass a temporary.");
+  return detail::task_guard_awaiter<task_scope_success<std::decay_t<F>, T>, detail::on_task_success_policy, std::decay_t<F>>{std::move(action)};
+}
+
+// sync_wait starts the task and blocks until it completes, possibly resumed on other threads; returns its result or rethrows.
+template <typename T>
+T sync_wait(task<T> awaited) {
+  using R = std::conditional_t<std::is_void_v<T>, bool, T>;
+  std::optional<R> result;
+  std::exception_ptr exception;
+  detail::sync_wait_state state;
+  detail::sync_wait_task waiter = detail::sync_wait_body(awaited, result, exception);
+  waiter.handle.promise().state = &state;
+  waiter.handle.resume();
+  {
+    std::unique_lock<std::mutex> lock{state.mutex};
+    state.done_cv.wait(lock, [&state]() { return state.done; });
+  }
+  waiter.handle.destroy();
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
+  if constexpr (!std::is_void_v<T>) {
+    return std::move(*result);
+  }
+}
+
+NEARGYE_SCOPE_GUARD_HOOK_NAMESPACE_END
+
+} // namespace scope_guard
+
+#endif // NEARGYE_SCOPE_GUARD_COROUTINES
+
+#endif // NEARGYE_SCOPE_GUARD_CORO_HPP
@@ -0,0 +1,517 @@
+//   _____                         _____                     _    _____
+//  / ____|                       / ____|                   | |  / ____|_     _
+// | (___   ___ ___  _ __   ___  | |  __ _   _  __ _ _ __ __| | | |   _| |_ _| |_
+//  \___ \ / __/ _ \| '_ \ / _ \ | | |_ | | | |/ _` | '__/ _` | | |  |_   _|_   _|
+//  ____) | (_| (_) | |_) |  __/ | |__| | |_| | (_| | | | (_| | | |____|_|   |_|
+// |_____/ \___\___/| .__/ \___|  \_____|\__,_|\__,_|_|  \__,_|  \_____|
+//                  | | https://github.com/Neargye/scope_guard
+//                  |_| version 0.9.4
+//
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018 - 2026 Daniil Goncharov <neargye@gmail.com>.
+//
+// Permission is hereby  granted, free of charge, to any  person obtaining a copy
+// of this software and associated  documentation files (the "Software"), to deal
+// in the Software  without restriction, including without  limitation the rights
+// to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+// copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+// IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+// FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+// AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+// LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef NEARGYE_SCOPE_GUARD_EPOCH_HPP
+#define NEARGYE_SCOPE_GUARD_EPOCH_HPP
+
+#include "scope_guard.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// scope_guard epoch settings:
+// SCOPE_GUARD_EPOCH_RETIRE_BATCH number of objects a thread retires before it tries to advance the epoch and free them, 64 by default.
+
+#if !defined(SCOPE_GUARD_EPOCH_RETIRE_BATCH)
+#  define SCOPE_GUARD_EPOCH_RETIRE_BATCH 64
+#endif
+
+namespace scope_guard {
+
+namespace detail {
+
+template <typename T, typename D>
+struct epoch_delete {
+  D& deleter;
+  T* object;
+
+  void operator()() {
+    deleter(object);
+  }
+};
+
+// epoch_retired is an object waiting for the readers of its epoch, with its deleter stored inline or allocated.
+struct epoch_retired {
+  void* object;
+  void (*reclaim)(epoch_retired&) noexcept;
+  alignas(void*) unsigned char deleter[sizeof(void*)];
+};
+
+template <typename D>
+struct is_epoch_inline_deleter
+    : std::integral_constant<bool, sizeof(D) <= sizeof(void*) && alignof(D) <= alignof(void*) && std::is_trivially_copyable<D>::value> {};
+
+// Deleters run where the object is freed, not where it was retired, so their exceptions are suppressed.
+template <typename T, typename D>
+void epoch_reclaim_inline(epoch_retired& retired) noexcept {
+  epoch_delete<T, D> action{*static_cast<D*>(static_cast<void*>(retired.deleter)), static_cast<T*>(retired.object)};
+  suppress_throw_action::invoke(action);
+}
+
+template <typename T, typename D>
+void epoch_reclaim_allocated(epoch_retired& retired) noexcept {
+  std::unique_ptr<D> deleter{*static_cast<D**>(static_cast<void*>(retired.deleter))};
+  epoch_delete<T, D> action{*deleter, static_cast<T*>(retired.object)};
+  suppress_throw_action::invoke(action);
+}
+
+// Takes the objects out of the list before running their deleters, because a deleter may retire more objects (e.g. the
+// children of a node) into the same list. The emptied buffer is given back if nothing was retired meanwhile.
+inline void epoch_reclaim_all(std::vector<epoch_retired>& retired) noexcept {
+  std::vector<epoch_retired> ready;
+  ready.swap(retired);
+  for (epoch_retired& r : ready) {
+    r.reclaim(r);
+  }
+  ready.clear();
+  if (retired.empty()) {
+    retired.swap(ready);
+  }
+}
+
+// Readers write their own record on every epoch_guard, so records and the global epoch each get a cache line.
+constexpr std::size_t epoch_cache_line = 64;
+
+// epoch_record announces the epoch observed by a thread in a read-side critical section: the epoch with the low bit set
+// while active, 0 otherwise. Records are never freed while the domain lives, a record of an exited thread is reused.
+struct alignas(epoch_cache_line) epoch_record {
+  std::atomic<unsigned int> state;
+  std::atomic<bool> in_use;
+  epoch_record* next;
+  void* allocation;
+
+  // Over-aligned new is C++17, so the record is placed in a larger allocation.
+  static epoch_record* create() {
+    void* allocation = ::operator new(sizeof(epoch_record) + alignof(epoch_record));
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(allocation) + alignof(epoch_record);
+    epoch_record* r = ::new (reinterpret_cast<void*>(address - address % alignof(epoch_record))) epoch_record{};
+    r->allocation = allocation;
+    return r;
+  }
+
+  static void destroy(epoch_record* r) noexcept {
+    void* allocation = r->allocation;
+    r->~epoch_record();
+    ::operator delete(allocation);
+  }
+};
+
+// Objects retired by a thread that exited, freed by the threads that reclaim after it.
+// They form a list, so that ready ones can be unlinked under the lock and freed after it without allocating.
+struct epoch_orphans {
+  unsigned int epoch;
+  std::vector<epoch_retired> retired;
+  epoch_orphans* next;
+};
+
+// epoch_domain keeps the global epoch, which only takes even values and advances by 2 once every active reader has
+// announced the current epoch. An object retired at epoch e may still be reached by readers of epoch e, but not by readers
+// that entered after the epoch advanced, so it is freed once the global epoch is e + 4.
+//
+// Readers announce with an exchange and advancing scans the records with read-modify-writes, so that either the scan sees
+// the reader, or the reader synchronizes with the scan and sees every object unlinked before it. Retiring reads the epoch
+// with a read-modify-write too, so an object is unlinked before any advance that counts towards freeing it.
+class epoch_domain {
+  alignas(epoch_cache_line) std::atomic<unsigned int> epoch_;
+  alignas(epoch_cache_line) std::atomic<epoch_record*> records_;
+  std::atomic<bool> has_orphans_;
+  std::mutex orphans_mutex_;
+  epoch_orphans* orphans_;
+
+ public:
+  epoch_domain() noexcept : epoch_{0}, records_{nullptr}, has_orphans_{false}, orphans_{nullptr} {}
+
+  epoch_domain(const epoch_domain&) = delete;
+  epoch_domain& operator=(const epoch_domain&) = delete;
+
+  unsigned int epoch() const noexcept {
+    return epoch_.load(std::memory_order_acquire);
+  }
+
+  unsigned int retire_epoch() noexcept {
+    return epoch_.fetch_add(0, std::memory_order_acq_rel);
+  }
+
+  epoch_record& acquire_record() {
+    for (epoch_record* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+      bool expected = false;
+      if (!r->in_use.load(std::memory_order_relaxed) && r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        return *r;
+      }
+    }
+    epoch_record* r = epoch_record::create();
+    r->state.store(0, std::memory_order_relaxed);
+    r->in_use.store(true, std::memory_order_relaxed);
+    r->next = records_.load(std::memory_order_relaxed);
+    while (!records_.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed)) {}
+    return *r;
+  }
+
+  void release_record(epoch_record& record) noexcept {
+    record.in_use.store(false, std::memory_order_release);
+  }
+
+  void enter(epoch_record& record) noexcept {
+    record.state.exchange(epoch() | 1, std::memory_order_acq_rel);
+  }
+
+  static void leave(epoch_record& record) noexcept {
+    record.state.store(0, std::memory_order_release);
+  }
+
+  // Advances the epoch if every active reader is in the current one. Returns false if a reader is in an older epoch.
+  bool try_advance() noexcept {
+    unsigned int e = epoch_.load(std::memory_order_acquire);
+    for (epoch_record* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+      const unsigned int s = r->state.fetch_or(0, std::memory_order_acq_rel);
+      if ((s & 1) != 0 && (s & ~1u) != e) {
+        return false;
+      }
+    }
+    epoch_.compare_exchange_strong(e, e + 2, std::memory_order_acq_rel, std::memory_order_relaxed);
+    return true;
+  }
+
+  void adopt(unsigned int epoch, std::vector<epoch_retired>&& retired) {
+    epoch_orphans* o = new epoch_orphans{epoch, std::move(retired), nullptr};
+    std::lock_guard<std::mutex> lock{orphans_mutex_};
+    o->next = orphans_;
+    orphans_ = o;
+    has_orphans_.store(true, std::memory_order_release);
+  }
+
+  bool has_orphans() const noexcept {
+    return has_orphans_.load(std::memory_order_acquire);
+  }
+
+  // Unlinks the orphans no reader can reach under the lock, then runs their deleters without it: a deleter may retire
+  // more objects, which can end up in the list again. The epoch is read under the lock, so that it is not older than the
+  // epoch of any orphan in the list.
+  void reclaim_orphans() noexcept {
+    epoch_orphans* ready = nullptr;
+    {
+      std::lock_guard<std::mutex> lock{orphans_mutex_};
+      const unsigned int e = epoch();
+      for (epoch_orphans** link = &orphans_; *link != nullptr;) {
+        epoch_orphans* o = *link;
+        if (e - o->epoch >= 4) {
+          *link = o->next;
+          o->next = ready;
+          ready = o;
+        } else {
+          link = &o->next;
+        }
+      }
+      has_orphans_.store(orphans_ != nullptr, std::memory_order_release);
+    }
+    while (ready != nullptr) {
+      std::unique_ptr<epoch_orphans> o{ready};
+      ready = o->next;
+      epoch_reclaim_all(o->retired);
+    }
+  }
+
+  // Retires an object of a thread whose epoch_thread was already destroyed (from a later thread_local destructor).
+  void push(const epoch_retired& r) {
+    std::vector<epoch_retired> retired{r};
+    adopt(retire_epoch(), std::move(retired));
+  }
+
+  void reclaim() noexcept {
+    try_advance();
+    if (has_orphans()) {
+      reclaim_orphans();
+    }
+  }
+
+  void synchronize() noexcept {
+    reclaim();
+    while (has_orphans()) {
+      std::this_thread::yield();
+      reclaim();
+    }
+  }
+
+  ~epoch_domain() {
+    while (orphans_ != nullptr) {
+      std::unique_ptr<epoch_orphans> o{orphans_};
+      orphans_ = o->next;
+      epoch_reclaim_all(o->retired);
+    }
+    for (epoch_record* r = records_.load(std::memory_order_acquire); r != nullptr;) {
+      epoch_record* next = r->next;
+      epoch_record::destroy(r);
+      r = next;
+    }
+  }
+};
+
+// The domain is destroyed at exit, after the threads that used it have exited.
+inline epoch_domain& default_epoch_domain() {
+  static epoch_domain domain;
+  return domain;
+}
+
+class epoch_thread;
+
+// epoch_thread_slot caches the address of the calling thread's epoch_thread in a trivial thread_local: a thread_local with
+// a destructor is reached through an initialization wrapper. After its destructor ran, destroyed is set, so thread_local
+// destructors that run later fall back to the domain instead of using the destroyed epoch_thread.
+struct epoch_thread_slot {
+  epoch_thread* thread;
+  bool destroyed;
+};
+
+inline epoch_thread_slot& this_epoch_thread_slot() noexcept {
+  static thread_local epoch_thread_slot slot = {nullptr, false};
+  return slot;
+}
+
+// epoch_thread is the per-thread state: the record, the nesting of epoch_guard and the retired objects in three batches,
+// one per epoch that can still have readers.
+class epoch_thread {
+  struct batch {
+    unsigned int epoch;
+    std::vector<epoch_retired> retired;
+  };
+
+  epoch_domain& domain_;
+  epoch_record& record_;
+  std::size_t depth_;
+  std::size_t pending_;
+  batch batches_[3];
+
+  batch& batch_of(unsigned int epoch) noexcept {
+    return batches_[(epoch >> 1) % 3];
+  }
+
+ public:
+  explicit epoch_thread(epoch_domain& domain) : domain_{domain}, record_{domain.acquire_record()}, depth_{0}, pending_{0}, batches_{} {}
+
+  epoch_thread(const epoch_thread&) = delete;
+  epoch_thread& operator=(const epoch_thread&) = delete;
+
+  void enter() noexcept {
+    if (depth_++ == 0) {
+      domain_.enter(record_);
+    }
+  }
+
+  void leave() noexcept {
+    if (--depth_ == 0) {
+      epoch_domain::leave(record_);
+    }
+  }
+
+  void push(const epoch_retired& r) {
+    const unsigned int e = domain_.retire_epoch();
+    batch& b = batch_of(e);
+    if (b.epoch != e) {
+      // The batch is from three epochs ago, so it has no readers left. It is relabeled first, so that objects retired by
+      // its deleters are not freed with it.
+      pending_ -= b.retired.size();
+      b.epoch = e;
+      if (!b.retired.empty()) {
+        epoch_reclaim_all(b.retired);
+      }
+    }
+    b.retired.push_back(r);
+    if (++pending_ >= SCOPE_GUARD_EPOCH_RETIRE_BATCH) {
+      reclaim();
+    }
+  }
+
+  // Tries to advance the epoch, then frees the batches and the orphans that no reader can reach.
+  void reclaim() noexcept {
+    domain_.try_advance();
+    for (batch& b : batches_) {
+      // The epoch is read for every batch: deleters of an earlier batch may have advanced it and retired into this one.
+      if (!b.retired.empty() && domain_.epoch() - b.epoch >= 4) {
+        pending_ -= b.retired.size();
+        epoch_reclaim_all(b.retired);
+      }
+    }
+    if (domain_.has_orphans()) {
+      domain_.reclaim_orphans();
+    }
+  }
+
+  void synchronize() noexcept {
+    reclaim();
+    while (pending_ != 0 || domain_.has_orphans()) {
+      std::this_thread::yield();
+      reclaim();
+    }
+  }
+
+  bool in_critical_section() const noexcept {
+    return depth_ != 0;
+  }
+
+  ~epoch_thread() {
+    epoch_thread_slot& slot = this_epoch_thread_slot();
+    slot.thread = nullptr;
+    slot.destroyed = true;
+    reclaim();
+    for (batch& b : batches_) {
+      if (!b.retired.empty()) {
+        domain_.adopt(b.epoch, std::move(b.retired));
+      }
+    }
+    domain_.release_record(record_);
+  }
+};
+
+inline epoch_thread& make_epoch_thread() {
+  static thread_local epoch_thread thread{default_epoch_domain()};
+  return thread;
+}
+
+// Returns nullptr once the calling thread's epoch_thread has been destroyed.
+inline epoch_thread* this_epoch_thread() {
+  epoch_thread_slot& slot = this_epoch_thread_slot();
+  if (slot.thread == nullptr && !slot.destroyed) {
+    slot.thread = &make_epoch_thread();
+  }
+  return slot.thread;
+}
+
+// Pushes a retired object to S, an epoch_thread or the domain, with the deleter stored inline or allocated.
+template <typename S, typename T, typename D>
+void epoch_retire(S& sink, T* object, D&& deleter, std::true_type) {
+  epoch_retired r{object, &epoch_reclaim_inline<T, typename std::decay<D>::type>, {}};
+  ::new (static_cast<void*>(r.deleter)) typename std::decay<D>::type(std::forward<D>(deleter));
+  sink.push(r);
+}
+
+template <typename S, typename T, typename D>
+void epoch_retire(S& sink, T* object, D&& deleter, std::false_type) {
+  using deleter_type = typename std::decay<D>::type;
+  std::unique_ptr<deleter_type> allocated{new deleter_type(std::forward<D>(deleter))};
+  epoch_retired r{object, &epoch_reclaim_allocated<T, deleter_type>, {}};
+  ::new (static_cast<void*>(r.deleter)) deleter_type*(allocated.get());
+  sink.push(r);
+  allocated.release();
+}
+
+// epoch_leave is the action of the scope_exit that ends a read-side critical section. After the thread's epoch_thread was
+// destroyed, the guard borrows a record of the domain for its duration.
+class epoch_leave {
+  epoch_thread* thread_;
+  epoch_record* record_;
+
+ public:
+  epoch_leave() : thread_{this_epoch_thread()}, record_{nullptr} {
+    if (thread_ != nullptr) {
+      thread_->enter();
+    } else {
+      record_ = &default_epoch_domain().acquire_record();
+      default_epoch_domain().enter(*record_);
+    }
+  }
+
+  void operator()() noexcept {
+    if (thread_ != nullptr) {
+      thread_->leave();
+    } else {
+      epoch_domain::leave(*record_);
+      default_epoch_domain().release_record(*record_);
+    }
+  }
+};
+
+// epoch_guard is a read-side critical section: objects retired with defer_retire after it started are not freed
+// until it ends. Guards nest, only the outermost one is announced to writers.
+class epoch_guard {
+  scope_guard<epoch_leave, on_exit_always_policy, no_throw_action> leave_;
+
+ public:
+  epoch_guard() : leave_{scope_guard_construct_tag{}, epoch_leave{}} {}
+
+  epoch_guard(const epoch_guard&) = delete;
+  epoch_guard& operator=(const epoch_guard&) = delete;
+};
+
+// defer_retire hands an object that was unlinked from a shared structure to the calling thread's retire list. The deleter is
+// invoked with the object once every epoch_guard that could have reached it has ended, on a thread that calls defer_retire,
+// epoch_reclaim or epoch_synchronize later. If it throws (out of memory), the object is not retired.
+// From a thread_local destructor that runs after the thread's epoch state was destroyed, the object goes to the domain.
+template <typename T, typename D = std::default_delete<T>>
+void defer_retire(T* object, D&& deleter = D{}) {
+  using inline_deleter = is_epoch_inline_deleter<typename std::decay<D>::type>;
+  if (epoch_thread* thread = this_epoch_thread()) {
+    epoch_retire(*thread, object, std::forward<D>(deleter), inline_deleter{});
+  } else {
+    epoch_retire(default_epoch_domain(), object, std::forward<D>(deleter), inline_deleter{});
+  }
+}
+
+// epoch_reclaim tries to advance the epoch and frees the retired objects no reader can reach, without waiting.
+inline void epoch_reclaim() noexcept {
+  if (epoch_thread* thread = this_epoch_thread()) {
+    thread->reclaim();
+  } else {
+    default_epoch_domain().reclaim();
+  }
+}
+
+// epoch_synchronize waits until every object retired by the calling thread, or by threads that exited, has been freed.
+// Inside an epoch_guard it would wait for itself, so it only reclaims without waiting.
+inline void epoch_synchronize() noexcept {
+  epoch_thread* thread = this_epoch_thread();
+  if (thread == nullptr) {
+    default_epoch_domain().synchronize();
+  } else if (thread->in_critical_section()) {
+    thread->reclaim();
+  } else {
+    thread->synchronize();
+  }
+}
+
+} // namespace scope_guard::detail
+
+using detail::epoch_guard;
+using detail::defer_retire;
+using detail::epoch_reclaim;
+using detail::epoch_synchronize;
+
+} // namespace scope_guard
+
+#endif // NEARGYE_SCOPE_GUARD_EPOCH_HPP
@@ -0,0 +1,97 @@
+//   _____                         _____                     _    _____
+//  / ____|                       / ____|                   | |  / ____|_     _
+// | (___   ___ ___  _ __   ___  | |  __ _   _  __ _ _ __ __| | | |   _| |_ _| |_
+//  \___ \ / __/ _ \| '_ \ / _ \ | | |_ | | | |/ _` | '__/ _` | | |  |_   _|_   _|
+//  ____) | (_| (_) | |_) |  __/ | |__| | |_| | (_| | | | (_| | | |____|_|   |_|
+// |_____/ \___\___/| .__/ \___|  \_____|\__,_|\__,_|_|  \__,_|  \_____|
+//                  | | https://github.com/Neargye/scope_guard
+//                  |_| version 0.9.4
+//
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018 - 2026 Daniil Goncharov <neargye@gmail.com>.
+//
+// Permission is hereby  granted, free of charge, to any  person obtaining a copy
+// of this software and associated  documentation files (the "Software"), to deal
+// in the Software  without restriction, including without  limitation the rights
+// to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+// copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+// IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+// FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+// AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+// LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef NEARGYE_SCOPE_GUARD_FIBER_HPP
+#define NEARGYE_SCOPE_GUARD_FIBER_HPP
+
+#include "scope_guard.hpp"
+
+// The exception state of a thread is kept in __cxa_eh_globals by the Itanium C++ ABI runtimes (libsupc++, libc++abi).
+// On other runtimes, a fiber scheduler provides the count with SCOPE_GUARD_UNCAUGHT_EXCEPTIONS_HOOK instead.
+#if defined(NEARGYE_SCOPE_GUARD_ITANIUM_EH_GLOBALS)
+
+namespace scope_guard {
+
+namespace detail {
+
+struct __cxa_eh_globals;
+extern "C" __cxa_eh_globals* __cxa_get_globals() noexcept;
+
+// Layout of __cxa_eh_globals: the stack of caught exceptions and the uncaught exceptions count, plus the propagating
+// exceptions of the ARM EHABI.
+struct eh_globals {
+  void* caught_exceptions;
+  unsigned int uncaught_exceptions;
+#if defined(__ARM_EABI_UNWINDER__)
+  void* propagating_exceptions;
+#endif
+};
+
+inline eh_globals* current_eh_globals() noexcept {
+  return static_cast<eh_globals*>(static_cast<void*>(__cxa_get_globals()));
+}
+
+} // namespace scope_guard::detail
+
+class fiber_exception_state;
+
+inline void switch_exception_state(fiber_exception_state& from, fiber_exception_state& to) noexcept;
+
+// fiber_exception_state holds the exception state of a fiber while it is switched out, a new fiber has none.
+// The thread's own context (e.g. the scheduler loop) needs one too, to be switched back to.
+class fiber_exception_state {
+  friend void switch_exception_state(fiber_exception_state& from, fiber_exception_state& to) noexcept;
+
+  detail::eh_globals saved_;
+
+ public:
+  fiber_exception_state() noexcept : saved_{} {}
+
+  fiber_exception_state(const fiber_exception_state&) = delete;
+  fiber_exception_state& operator=(const fiber_exception_state&) = delete;
+};
+
+// switch_exception_state saves the exception state of the thread into from and restores the state of to.
+// Call it right before switching stacks, on the thread that runs the fiber next, so the uncaught exceptions count and
+// the caught exceptions (std::current_exception, throw;) follow the fiber instead of the thread, even mid-unwind.
+// The state is swapped in place, so the per-thread address cached by scope_guard stays valid.
+inline void switch_exception_state(fiber_exception_state& from, fiber_exception_state& to) noexcept {
+  detail::eh_globals* globals = detail::current_eh_globals();
+  from.saved_ = *globals;
+  *globals = to.saved_;
+}
+
+} // namespace scope_guard
+
+#endif // NEARGYE_SCOPE_GUARD_ITANIUM_EH_GLOBALS
+
+#endif // NEARGYE_SCOPE_GUARD_FIBER_HPP
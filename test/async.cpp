@@ -0,0 +1,159 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#include <scope_guard_async.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("scope_exit_async runs the action on a worker") {
+  scope_guard::async_executor executor{1, 16};
+  std::atomic<int> count{0};
+  std::thread::id runner;
+  {
+    auto guard = scope_guard::make_scope_exit_async(executor, [&count, &runner]() {
+      runner = std::this_thread::get_id();
+      ++count;
+    });
+  }
+  executor.flush();
+  REQUIRE(count == 1);
+  REQUIRE(runner != std::this_thread::get_id());
+
+  {
+    auto guard = scope_guard::make_scope_exit_async(executor, [&count]() { ++count; });
+    guard.dismiss();
+  }
+  executor.flush();
+  REQUIRE(count == 1);
+}
+
+TEST_CASE("DEFER_ASYNC captures by copy") {
+  scope_guard::async_executor executor{2, 16};
+  std::shared_ptr<std::atomic<int>> count = std::make_shared<std::atomic<int>>(0);
+  {
+    DEFER_ASYNC_ON(executor){ ++*count; };
+    DEFER_ASYNC_ON(executor){ ++*count; };
+  }
+  executor.flush();
+  REQUIRE(*count == 2);
+
+  {
+    DEFER_ASYNC{ ++*count; };
+  }
+  scope_guard::default_async_executor().flush();
+  REQUIRE(*count == 3);
+}
+
+// Destroyed after the default executor was closed at exit, its action runs inline instead of on a stopped worker.
+struct defer_async_at_exit {
+  ~defer_async_at_exit() {
+    DEFER_ASYNC{ std::fflush(stdout); };
+  }
+} defer_at_exit;
+
+TEST_CASE("a closed executor runs actions inline") {
+  scope_guard::async_executor executor{1, 16};
+  std::atomic<int> count{0};
+  executor.submit([&count]() { ++count; });
+  executor.close();
+  REQUIRE(count == 1);
+
+  std::thread::id runner;
+  {
+    auto guard = scope_guard::make_scope_exit_async(executor, [&count, &runner]() {
+      runner = std::this_thread::get_id();
+      ++count;
+    });
+  }
+  REQUIRE(count == 2);
+  REQUIRE(runner == std::this_thread::get_id());
+}
+
+TEST_CASE("full queues fall back to inline execution") {
+  scope_guard::async_executor executor{1, 2};
+  std::atomic<bool> release{false};
+  std::atomic<int> count{0};
+  std::thread::id runner;
+
+  // The first action occupies its cell until released, so the queue of two has room for one more action.
+  executor.submit([&release]() {
+    while (!release.load()) {
+      std::this_thread::yield();
+    }
+  });
+  executor.submit([&count]() { ++count; });
+  {
+    auto guard = scope_guard::make_scope_exit_async(executor, [&count, &runner]() {
+      runner = std::this_thread::get_id();
+      ++count;
+    });
+  }
+  REQUIRE(count >= 1);
+  REQUIRE(runner == std::this_thread::get_id());
+
+  release = true;
+  executor.flush();
+  REQUIRE(count == 2);
+}
+
+TEST_CASE("executor without workers runs inline") {
+  scope_guard::async_executor executor{0};
+  int count = 0;
+  {
+    auto guard = scope_guard::make_scope_exit_async(executor, [&count]() { ++count; });
+  }
+  REQUIRE(count == 1);
+  executor.flush();
+}
+
+struct LargeAction {
+  std::atomic<int>* count;
+  unsigned char payload[256];
+
+  void operator() () {
+    *count += payload[255];
+  }
+};
+
+TEST_CASE("large actions are allocated, exceptions are suppressed") {
+  scope_guard::async_executor executor{1, 16};
+  std::atomic<int> count{0};
+  LargeAction large{&count, {}};
+  large.payload[255] = 7;
+  {
+    auto guard = scope_guard::make_scope_exit_async(executor, std::move(large));
+    auto throwing = scope_guard::make_scope_exit_async(executor, []() { throw std::runtime_error{"error"}; });
+  }
+  executor.flush();
+  REQUIRE(count == 7);
+}
+
+TEST_CASE("many producers") {
+  constexpr int producers = 4;
+  constexpr int actions = 10000;
+  scope_guard::async_executor executor{2, 64};
+  std::atomic<int> count{0};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < producers; ++i) {
+    threads.emplace_back([&executor, &count]() {
+      for (int j = 0; j < actions; ++j) {
+        auto guard = scope_guard::make_scope_exit_async(executor, [&count]() { count.fetch_add(1, std::memory_order_relaxed); });
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  executor.flush();
+  REQUIRE(count == producers * actions);
+}
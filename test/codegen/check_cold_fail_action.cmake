@@ -0,0 +1,27 @@
+# Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+# SPDX-License-Identifier: MIT
+
+# Compares the size of SYMBOL in HOT_OBJECT (default build) and COLD_OBJECT (SCOPE_GUARD_COLD_FAIL_ACTION).
+
+function(symbol_size object result)
+    execute_process(COMMAND ${NM} -S --defined-only ${object}
+                    OUTPUT_VARIABLE output
+                    RESULT_VARIABLE status)
+    if(NOT status EQUAL 0)
+        message(FATAL_ERROR "${NM} failed on ${object}")
+    endif()
+    string(REGEX MATCH "[0-9a-fA-F]+ ([0-9a-fA-F]+) [Tt] ${SYMBOL}\n" line "${output}")
+    if(NOT line)
+        message(FATAL_ERROR "${SYMBOL} not found in ${object}")
+    endif()
+    math(EXPR size "0x${CMAKE_MATCH_1}")
+    set(${result} ${size} PARENT_SCOPE)
+endfunction()
+
+symbol_size(${HOT_OBJECT} hot_size)
+symbol_size(${COLD_OBJECT} cold_size)
+message(STATUS "${SYMBOL}: ${hot_size} bytes, ${cold_size} bytes with SCOPE_GUARD_COLD_FAIL_ACTION")
+
+if(NOT cold_size LESS hot_size)
+    message(FATAL_ERROR "SCOPE_GUARD_COLD_FAIL_ACTION did not shrink ${SYMBOL}")
+endif()
@@ -0,0 +1,44 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+
+// Compiled with and without SCOPE_GUARD_COLD_FAIL_ACTION, the size of handle_request is compared by check_cold_fail_action.cmake.
+
+#include <scope_guard.hpp>
+
+struct Row {
+  int key;
+  int value;
+  int version;
+};
+
+extern "C" void log_rollback(const char* what, int key, int value);
+extern "C" bool store(Row* rows, int n);
+
+extern "C" bool handle_request(Row* rows, int n) {
+  SCOPE_FAIL{
+    for (int i = 0; i < n; ++i) {
+      rows[i].value -= rows[i].version;
+      rows[i].version = 0;
+      log_rollback("rows", rows[i].key, rows[i].value);
+    }
+  };
+  for (int i = 0; i < n; ++i) {
+    ++rows[i].version;
+  }
+
+  SCOPE_FAIL{
+    for (int i = n - 1; i >= 0; --i) {
+      rows[i].key ^= rows[i].value;
+      log_rollback("keys", rows[i].key, i);
+    }
+  };
+  for (int i = 0; i < n; ++i) {
+    rows[i].key ^= rows[i].value;
+  }
+
+  SCOPE_FAIL{
+    log_rollback("store", n, rows[0].key * 31 + rows[n - 1].value);
+    rows[0].version = -1;
+  };
+  return store(rows, n);
+}
@@ -0,0 +1,15 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+
+#include <scope_guard.hpp>
+
+struct LargeAction {
+  char data[64];
+
+  void operator() () {}
+};
+
+int main() {
+  scope_guard::any_scope_exit<32> sg{LargeAction{}};
+  (void)sg;
+}
@@ -0,0 +1,15 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+
+#include <scope_guard.hpp>
+
+struct Policy {
+  explicit Policy(bool) noexcept {}
+
+  void dismiss() noexcept {}
+};
+
+int main() {
+  auto sg = scope_guard::make_scope_guard<Policy>([]() {});
+  (void)sg;
+}
@@ -0,0 +1,13 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+
+#include <scope_guard.hpp>
+
+bool make_status() {
+  return true;
+}
+
+int main() {
+  auto sg = scope_guard::make_scope_fail_on(make_status(), []() {});
+  (void)sg;
+}
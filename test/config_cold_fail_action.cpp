@@ -0,0 +1,36 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#define SCOPE_GUARD_COLD_FAIL_ACTION
+#include <scope_guard.hpp>
+
+#include <stdexcept>
+
+TEST_CASE("SCOPE_GUARD_COLD_FAIL_ACTION keeps scope_fail semantics") {
+  int fail_count = 0;
+  int success_count = 0;
+
+  [&]() {
+    SCOPE_FAIL{ ++fail_count; };
+    SCOPE_SUCCESS{ ++success_count; };
+  }();
+  REQUIRE(fail_count == 0);
+  REQUIRE(success_count == 1);
+
+  REQUIRE_THROWS([&]() {
+    SCOPE_FAIL{ ++fail_count; };
+    SCOPE_SUCCESS{ ++success_count; };
+    throw std::runtime_error{"failure"};
+  }());
+  REQUIRE(fail_count == 1);
+  REQUIRE(success_count == 1);
+
+  [&]() {
+    bool ok = false;
+    SCOPE_FAIL_ON(ok){ ++fail_count; };
+  }();
+  REQUIRE(fail_count == 2);
+}
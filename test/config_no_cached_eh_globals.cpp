@@ -0,0 +1,37 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#define SCOPE_GUARD_NO_CACHED_EH_GLOBALS
+#include <scope_guard.hpp>
+
+#include <stdexcept>
+
+// Built as C++11, where the count is read through __cxa_get_globals() on every call instead of std::uncaught_exceptions.
+TEST_CASE("SCOPE_GUARD_NO_CACHED_EH_GLOBALS keeps scope_fail and scope_success semantics") {
+  int fail_count = 0;
+  int success_count = 0;
+
+  [&]() {
+    SCOPE_FAIL{ ++fail_count; };
+    SCOPE_SUCCESS{ ++success_count; };
+  }();
+  REQUIRE(fail_count == 0);
+  REQUIRE(success_count == 1);
+
+  REQUIRE_THROWS_AS([&]() {
+    SCOPE_FAIL{ ++fail_count; };
+    SCOPE_SUCCESS{ ++success_count; };
+    throw std::runtime_error{"failure"};
+  }(), std::runtime_error);
+  REQUIRE(fail_count == 1);
+  REQUIRE(success_count == 1);
+
+  try {
+    throw std::runtime_error{"outer"};
+  } catch (const std::runtime_error&) {
+    REQUIRE(scope_guard::detail::uncaught_exceptions() == 0);
+  }
+}
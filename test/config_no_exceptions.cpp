@@ -0,0 +1,92 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018 - 2026 Daniil Goncharov <neargye@gmail.com>.
+//
+// Permission is hereby  granted, free of charge, to any  person obtaining a copy
+// of this software and associated  documentation files (the "Software"), to deal
+// in the Software  without restriction, including without  limitation the rights
+// to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+// copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+// IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+// FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+// AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+// LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#include <scope_guard.hpp>
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#  error This test must be compiled with exceptions disabled.
+#endif
+
+TEST_CASE("scope_exit executes on scope leave") {
+  int count = 0;
+
+  [&]() {
+    SCOPE_EXIT{ ++count; };
+    MAKE_SCOPE_EXIT(sg){ ++count; };
+    auto sg2 = scope_guard::make_scope_exit([&]() { ++count; });
+    sg2.dismiss();
+  }();
+
+  CHECK(count == 2);
+}
+
+TEST_CASE("scope_fail never executes without exceptions") {
+  int count = 0;
+
+  [&]() {
+    SCOPE_FAIL{ ++count; };
+    auto sg = scope_guard::make_scope_fail([&]() { ++count; });
+  }();
+
+  CHECK(count == 0);
+}
+
+TEST_CASE("scope_success always executes without exceptions") {
+  int count = 0;
+
+  [&]() {
+    SCOPE_SUCCESS{ ++count; };
+    auto sg = scope_guard::make_scope_success([&]() { ++count; });
+  }();
+
+  CHECK(count == 2);
+}
+
+TEST_CASE("status-driven guards replace fail/success") {
+  int fail_count = 0;
+  int success_count = 0;
+
+  [&]() {
+    bool ok = false;
+    SCOPE_FAIL_ON(ok){ ++fail_count; };
+    SCOPE_SUCCESS_ON(ok){ ++success_count; };
+  }();
+
+  CHECK(fail_count == 1);
+  CHECK(success_count == 0);
+}
+
+TEST_CASE("scope_stack without exceptions") {
+  int order = 0;
+
+  [&]() {
+    scope_guard::scope_exit_stack<16> stack;
+    for (int i = 1; i <= 4; ++i) {
+      stack.push([&order, i]() { order = order * 10 + i; });
+    }
+  }();
+
+  CHECK(order == 4321);
+}
@@ -0,0 +1,26 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+
+// Linked without the C++ runtime: a reference to any exception runtime symbol
+// (__cxa_get_globals, std::uncaught_exceptions, __gxx_personality_v0, ...) fails the link.
+
+#include <scope_guard.hpp>
+
+int main() {
+  int count = 0;
+
+  {
+    SCOPE_EXIT{ ++count; };
+    SCOPE_FAIL{ count += 10; };
+    SCOPE_SUCCESS{ count += 100; };
+    MAKE_SCOPE_EXIT(sg){ count += 1000; };
+    sg.dismiss();
+  }
+
+  {
+    bool ok = false;
+    SCOPE_FAIL_ON(ok){ count += 10000; };
+  }
+
+  return count == 10101 ? 0 : 1;
+}
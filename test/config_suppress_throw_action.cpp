@@ -26,3 +26,18 @@ TEST_CASE("SCOPE_GUARD_SUPPRESS_THROW_ACTION suppresses cleanup exceptions") {
   REQUIRE(count == 1);
   REQUIRE(scope_guard_suppressed_exceptions == 1);
 }
+
+TEST_CASE("per-guard may_throw_action overrides SCOPE_GUARD_SUPPRESS_THROW_ACTION") {
+  int count = 0;
+  scope_guard_suppressed_exceptions = 0;
+
+  REQUIRE_THROWS_AS([&]() {
+    auto guard = scope_guard::make_scope_exit<scope_guard::may_throw_action>([&]() {
+      ++count;
+      throw std::runtime_error{"cleanup failure"};
+    });
+  }(), std::runtime_error);
+
+  REQUIRE(count == 1);
+  REQUIRE(scope_guard_suppressed_exceptions == 0);
+}
@@ -0,0 +1,66 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+// Stands in for the count a fiber scheduler keeps for the running fiber.
+static int fiber_uncaught = 0;
+
+static int fiber_uncaught_exceptions() noexcept {
+  return fiber_uncaught;
+}
+
+#define SCOPE_GUARD_UNCAUGHT_EXCEPTIONS_HOOK fiber_uncaught_exceptions
+#include <scope_guard.hpp>
+
+#include <stdexcept>
+
+TEST_CASE("SCOPE_GUARD_UNCAUGHT_EXCEPTIONS_HOOK provides the baseline and the check") {
+  int fail_count = 0;
+  int success_count = 0;
+
+  {
+    SCOPE_FAIL{ ++fail_count; };
+    SCOPE_SUCCESS{ ++success_count; };
+    fiber_uncaught = 1;
+  }
+  REQUIRE(fail_count == 1);
+  REQUIRE(success_count == 0);
+
+  {
+    auto on_fail = scope_guard::make_scope_fail([&]() { ++fail_count; });
+    auto on_success = scope_guard::make_scope_success([&]() { ++success_count; });
+    fiber_uncaught = 0;
+  }
+  REQUIRE(fail_count == 1);
+  REQUIRE(success_count == 1);
+
+  // The count of the thread is not consulted.
+  REQUIRE_THROWS_AS([&]() {
+    SCOPE_FAIL{ ++fail_count; };
+    SCOPE_SUCCESS{ ++success_count; };
+    throw std::runtime_error{"thread"};
+  }(), std::runtime_error);
+  REQUIRE(fail_count == 1);
+  REQUIRE(success_count == 2);
+}
+
+bool unhooked_scope_fail_runs(void (*body)());
+bool unhooked_scope_success_runs(void (*body)());
+
+TEST_CASE("SCOPE_GUARD_UNCAUGHT_EXCEPTIONS_HOOK does not change the guards of a translation unit without it") {
+  fiber_uncaught = 0;
+  REQUIRE_FALSE(unhooked_scope_fail_runs([]() { fiber_uncaught = 1; }));
+  fiber_uncaught = 0;
+  REQUIRE(unhooked_scope_success_runs([]() { fiber_uncaught = 1; }));
+  fiber_uncaught = 0;
+
+  int fail_count = 0;
+  {
+    SCOPE_FAIL{ ++fail_count; };
+    fiber_uncaught = 1;
+  }
+  fiber_uncaught = 0;
+  REQUIRE(fail_count == 1);
+}
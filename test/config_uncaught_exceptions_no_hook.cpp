@@ -0,0 +1,26 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+
+// Linked into the SCOPE_GUARD_UNCAUGHT_EXCEPTIONS_HOOK test, but compiled without the hook.
+#include <scope_guard.hpp>
+
+bool unhooked_scope_fail_runs(void (*body)());
+bool unhooked_scope_success_runs(void (*body)());
+
+bool unhooked_scope_fail_runs(void (*body)()) {
+  bool executed = false;
+  {
+    SCOPE_FAIL{ executed = true; };
+    body();
+  }
+  return executed;
+}
+
+bool unhooked_scope_success_runs(void (*body)()) {
+  bool executed = false;
+  {
+    SCOPE_SUCCESS{ executed = true; };
+    body();
+  }
+  return executed;
+}
@@ -0,0 +1,213 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#include <scope_guard_coro.hpp>
+
+#if defined(NEARGYE_SCOPE_GUARD_COROUTINES)
+#include <coroutine>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// Suspends the awaiting coroutine and resumes it inline, like an asynchronous operation that completes immediately.
+struct resume_inline {
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  bool await_suspend(std::coroutine_handle<>) const noexcept {
+    return false;
+  }
+
+  void await_resume() const noexcept {}
+};
+
+scope_guard::task<> close_async(std::string* log, std::string name) {
+  co_await resume_inline{};
+  *log += name;
+}
+
+scope_guard::task<int> exit_in_reverse_order(std::string* log) {
+  co_await scope_guard::co_scope_exit([log]() { return close_async(log, "a"); });
+  co_await scope_guard::co_scope_exit([log]() { return close_async(log, "b"); });
+  co_await scope_guard::co_scope_exit([log]() { *log += "c"; });
+  *log += "body;";
+  co_return 42;
+}
+
+TEST_CASE("co_scope_exit awaits cleanups in reverse order before the task completes") {
+  std::string log;
+  REQUIRE(scope_guard::sync_wait(exit_in_reverse_order(&log)) == 42);
+  REQUIRE(log == "body;cba");
+}
+
+scope_guard::task<> fail_and_success(std::string* log, bool fail) {
+  co_await scope_guard::co_scope_fail([log]() { return close_async(log, "fail;"); });
+  co_await scope_guard::co_scope_success([log]() { return close_async(log, "success;"); });
+  co_await scope_guard::co_scope_exit([log]() { return close_async(log, "exit;"); });
+  co_await resume_inline{};
+  if (fail) {
+    throw std::runtime_error{"error"};
+  }
+}
+
+TEST_CASE("co_scope_fail and co_scope_success") {
+  std::string log;
+  scope_guard::sync_wait(fail_and_success(&log, false));
+  REQUIRE(log == "exit;success;");
+
+  log.clear();
+  REQUIRE_THROWS_AS(scope_guard::sync_wait(fail_and_success(&log, true)), std::runtime_error);
+  REQUIRE(log == "exit;fail;");
+}
+
+scope_guard::task<> throwing_cleanup(std::string* log) {
+  co_await scope_guard::co_scope_exit([log]() { return close_async(log, "first"); });
+  co_await scope_guard::co_scope_exit([]() -> scope_guard::task<> {
+    co_await resume_inline{};
+    throw std::logic_error{"cleanup"};
+  });
+}
+
+TEST_CASE("remaining cleanups run if a cleanup throws") {
+  std::string log;
+  REQUIRE_THROWS_AS(scope_guard::sync_wait(throwing_cleanup(&log)), std::logic_error);
+  REQUIRE(log == "first");
+}
+
+scope_guard::task<> dismissed(std::string* log) {
+  auto rollback = co_await scope_guard::co_scope_exit([log]() { return close_async(log, "rollback"); });
+  co_await scope_guard::co_scope_exit([log]() { return close_async(log, "close"); });
+  rollback.dismiss();
+}
+
+TEST_CASE("dismiss a co_scope_exit") {
+  std::string log;
+  scope_guard::sync_wait(dismissed(&log));
+  REQUIRE(log == "close");
+}
+
+scope_guard::task<> nested(std::string* log) {
+  co_await scope_guard::co_scope_exit([log]() { return close_async(log, "outer;"); });
+  co_await exit_in_reverse_order(log);
+  *log += "after;";
+}
+
+TEST_CASE("nested tasks") {
+  std::string log;
+  scope_guard::sync_wait(nested(&log));
+  REQUIRE(log == "body;cbaafter;outer;");
+}
+// Resumes the awaiting coroutine on a new thread, optionally from a destructor that runs while an exception unwinds that thread.
+struct resume_on_new_thread {
+  std::thread* thread;
+  bool unwinding;
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) const {
+    std::thread* t = thread;
+    const bool u = unwinding;
+    *t = std::thread{[handle, u]() {
+      if (!u) {
+        handle.resume();
+        return;
+      }
+      struct resume_on_exit {
+        std::coroutine_handle<> handle;
+
+        ~resume_on_exit() {
+          handle.resume();
+        }
+      };
+      try {
+        resume_on_exit r{handle};
+        throw std::runtime_error{"unwinding"};
+      } catch (const std::runtime_error&) {}
+    }};
+  }
+
+  void await_resume() const noexcept {}
+};
+
+scope_guard::task<> task_guards(std::string* log, std::thread* thread, bool unwinding, bool fail) {
+  auto on_fail = co_await scope_guard::make_task_scope_fail([log]() { *log += "fail;"; });
+  auto on_success = co_await scope_guard::make_task_scope_success([log]() { *log += "success;"; });
+  co_await resume_on_new_thread{thread, unwinding};
+  *log += "resumed;";
+  if (fail) {
+    throw std::runtime_error{"error"};
+  }
+}
+
+TEST_CASE("make_task_scope_fail and make_task_scope_success on a thread that is unwinding") {
+  std::string log;
+  std::thread thread;
+  scope_guard::sync_wait(task_guards(&log, &thread, true, false));
+  thread.join();
+  REQUIRE(log == "resumed;success;");
+
+  log.clear();
+  REQUIRE_THROWS_AS(scope_guard::sync_wait(task_guards(&log, &thread, true, true)), std::runtime_error);
+  thread.join();
+  REQUIRE(log == "resumed;fail;");
+}
+
+// Runs the task to completion from a destructor, while an exception unwinds the calling thread.
+void sync_wait_unwinding(scope_guard::task<> awaited, bool* failed) {
+  struct wait_on_exit {
+    scope_guard::task<>* awaited;
+    bool* failed;
+
+    ~wait_on_exit() {
+      try {
+        scope_guard::sync_wait(std::move(*awaited));
+      } catch (const std::runtime_error&) {
+        *failed = true;
+      }
+    }
+  };
+  try {
+    wait_on_exit w{&awaited, failed};
+    throw std::logic_error{"unwinding"};
+  } catch (const std::logic_error&) {}
+}
+
+TEST_CASE("make_task_scope_fail and make_task_scope_success created while unwinding") {
+  std::string log;
+  std::thread thread;
+  bool failed = false;
+  sync_wait_unwinding(task_guards(&log, &thread, false, false), &failed);
+  thread.join();
+  REQUIRE_FALSE(failed);
+  REQUIRE(log == "resumed;success;");
+
+  log.clear();
+  sync_wait_unwinding(task_guards(&log, &thread, false, true), &failed);
+  thread.join();
+  REQUIRE(failed);
+  REQUIRE(log == "resumed;fail;");
+}
+
+scope_guard::task<> dismissed_task_guard(std::string* log, std::thread* thread) {
+  auto rollback = co_await scope_guard::make_task_scope_fail([log]() { *log += "rollback;"; });
+  auto commit = co_await scope_guard::make_task_scope_success([log]() { *log += "commit;"; });
+  co_await resume_on_new_thread{thread, false};
+  commit.dismiss();
+  rollback.dismiss();
+  throw std::runtime_error{"error"};
+}
+
+TEST_CASE("dismiss a make_task_scope_fail") {
+  std::string log;
+  std::thread thread;
+  REQUIRE_THROWS_AS(scope_guard::sync_wait(dismissed_task_guard(&log, &thread)), std::runtime_error);
+  thread.join();
+  REQUIRE(log.empty());
+}
+#endif
@@ -0,0 +1,241 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#include <scope_guard_epoch.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct counted {
+  std::atomic<int>* deleted;
+};
+
+struct counted_delete {
+  void operator()(counted* object) const noexcept {
+    ++*object->deleted;
+    delete object;
+  }
+};
+
+} // namespace
+
+TEST_CASE("defer_retire frees the object after the epoch_guard ends") {
+  std::atomic<int> deleted{0};
+  {
+    scope_guard::epoch_guard guard;
+    scope_guard::defer_retire(new counted{&deleted}, counted_delete{});
+    scope_guard::epoch_reclaim();
+    scope_guard::epoch_synchronize();
+    REQUIRE(deleted == 0);
+  }
+  scope_guard::epoch_synchronize();
+  REQUIRE(deleted == 1);
+}
+
+TEST_CASE("defer_retire waits for readers on other threads") {
+  std::atomic<int> deleted{0};
+  std::atomic<bool> entered{false};
+  std::atomic<bool> leave{false};
+  std::thread reader{[&]() {
+    scope_guard::epoch_guard outer;
+    {
+      scope_guard::epoch_guard nested;
+    }
+    entered = true;
+    while (!leave) {
+      std::this_thread::yield();
+    }
+  }};
+  while (!entered) {
+    std::this_thread::yield();
+  }
+
+  scope_guard::defer_retire(new counted{&deleted}, counted_delete{});
+  for (int i = 0; i < 8; ++i) {
+    scope_guard::epoch_reclaim();
+  }
+  REQUIRE(deleted == 0);
+
+  leave = true;
+  reader.join();
+  scope_guard::epoch_synchronize();
+  REQUIRE(deleted == 1);
+}
+
+TEST_CASE("defer_retire with a function and a stateful deleter") {
+  static std::atomic<int> function_deleted{0};
+  scope_guard::defer_retire(new int{1}, +[](int* object) {
+    ++function_deleted;
+    delete object;
+  });
+
+  // Larger than a pointer, so the deleter is allocated.
+  std::atomic<int> deleted{0};
+  std::vector<int> log;
+  scope_guard::defer_retire(new counted{&deleted}, [&log, &deleted](counted* object) {
+    log.push_back(deleted);
+    counted_delete{}(object);
+  });
+  scope_guard::defer_retire(new int{2});
+
+  scope_guard::epoch_synchronize();
+  REQUIRE(function_deleted == 1);
+  REQUIRE(deleted == 1);
+  REQUIRE(log.size() == 1);
+}
+
+namespace {
+
+struct chain_node {
+  chain_node* child;
+  std::atomic<int>* deleted;
+};
+
+// Retires the child from the deleter, like a lock-free structure that frees a subtree node by node.
+struct chain_delete {
+  void operator()(chain_node* node) const noexcept {
+    if (node->child != nullptr) {
+      scope_guard::defer_retire(node->child, chain_delete{});
+    }
+    ++*node->deleted;
+    delete node;
+  }
+};
+
+} // namespace
+
+TEST_CASE("deleters retire more objects") {
+  constexpr int nodes = 1000;
+  std::atomic<int> deleted{0};
+
+  SUBCASE("on the retiring thread") {
+    // Full batches of chain heads, so the deleters of one batch fill the next and reclaim again.
+    for (int j = 0; j < nodes / 5; ++j) {
+      chain_node* head = nullptr;
+      for (int i = 0; i < 5; ++i) {
+        head = new chain_node{head, &deleted};
+      }
+      scope_guard::defer_retire(head, chain_delete{});
+    }
+    scope_guard::epoch_synchronize();
+    REQUIRE(deleted == nodes);
+  }
+
+  SUBCASE("orphaned by an exited thread") {
+    std::thread t{[&]() {
+      for (int j = 0; j < nodes / 5; ++j) {
+        chain_node* head = nullptr;
+        for (int i = 0; i < 5; ++i) {
+          head = new chain_node{head, &deleted};
+        }
+        scope_guard::defer_retire(head, chain_delete{});
+      }
+    }};
+    t.join();
+    scope_guard::epoch_synchronize();
+    REQUIRE(deleted == nodes);
+  }
+}
+
+namespace {
+
+// Destroyed after the thread's epoch state, which is constructed later.
+struct retire_at_thread_exit {
+  std::atomic<int>* deleted;
+
+  ~retire_at_thread_exit() {
+    scope_guard::epoch_guard guard;
+    scope_guard::defer_retire(new counted{deleted}, counted_delete{});
+    scope_guard::epoch_reclaim();
+  }
+};
+
+} // namespace
+
+TEST_CASE("defer_retire from a thread_local destructor after the epoch state was destroyed") {
+  std::atomic<int> deleted{0};
+  std::thread t{[&]() {
+    static thread_local retire_at_thread_exit retire{&deleted};
+    (void)retire;
+    scope_guard::epoch_guard guard;
+    scope_guard::defer_retire(new counted{&deleted}, counted_delete{});
+  }};
+  t.join();
+
+  scope_guard::epoch_synchronize();
+  REQUIRE(deleted == 2);
+}
+
+namespace {
+
+constexpr int alive = 0x600d;
+constexpr int dead = 0xdead;
+
+struct node {
+  std::atomic<int> state;
+  int value;
+};
+
+struct node_delete {
+  std::atomic<int>* deleted;
+
+  void operator()(node* object) const noexcept {
+    object->state = dead;
+    ++*deleted;
+    delete object;
+  }
+};
+
+} // namespace
+
+TEST_CASE("stress readers and writers") {
+  constexpr int readers = 3;
+  constexpr int writers = 2;
+  constexpr int writes = 2000;
+
+  std::atomic<node*> shared{new node{{alive}, 0}};
+  std::atomic<int> deleted{0};
+  std::atomic<int> writers_done{0};
+  std::atomic<int> bad_reads{0};
+  std::atomic<long> reads{0};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < readers; ++i) {
+    threads.emplace_back([&]() {
+      while (writers_done != writers) {
+        scope_guard::epoch_guard guard;
+        node* n = shared.load(std::memory_order_acquire);
+        if (n->state.load(std::memory_order_relaxed) != alive) {
+          ++bad_reads;
+        }
+        ++reads;
+      }
+    });
+  }
+  for (int i = 0; i < writers; ++i) {
+    threads.emplace_back([&, i]() {
+      for (int j = 1; j <= writes; ++j) {
+        node* old = shared.exchange(new node{{alive}, i * writes + j}, std::memory_order_acq_rel);
+        scope_guard::defer_retire(old, node_delete{&deleted});
+      }
+      ++writers_done;
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  // Objects still pending when the writers exited are freed by the next thread that reclaims.
+  scope_guard::epoch_synchronize();
+  REQUIRE(bad_reads == 0);
+  REQUIRE(reads > 0);
+  REQUIRE(deleted == writers * writes);
+  node_delete{&deleted}(shared.load());
+}
@@ -0,0 +1,135 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+#include <scope_guard_fiber.hpp>
+
+#include <ucontext.h>
+
+#include <exception>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+struct fiber {
+  ucontext_t context;
+  scope_guard::fiber_exception_state exceptions;
+  std::vector<char> stack;
+
+  fiber() : context{}, exceptions{}, stack{} {}
+
+  fiber(void (*entry)()) : context{}, exceptions{}, stack(256 * 1024) {
+    getcontext(&context);
+    context.uc_stack.ss_sp = stack.data();
+    context.uc_stack.ss_size = stack.size();
+    context.uc_link = nullptr;
+    makecontext(&context, entry, 0);
+  }
+};
+
+void switch_fiber(fiber& from, fiber& to) {
+  scope_guard::switch_exception_state(from.exceptions, to.exceptions);
+  swapcontext(&from.context, &to.context);
+}
+
+fiber* main_fiber = nullptr;
+fiber* unwinding_fiber = nullptr;
+fiber* guard_fiber = nullptr;
+
+int fail_count = 0;
+int success_count = 0;
+bool caught = false;
+
+// Switches to the guard fiber from a destructor, while an exception unwinds the unwinding fiber.
+struct switch_on_exit {
+  ~switch_on_exit() {
+    switch_fiber(*unwinding_fiber, *guard_fiber);
+  }
+};
+
+void run_unwinding_fiber() {
+  try {
+    switch_on_exit s;
+    throw std::runtime_error{"unwinding"};
+  } catch (const std::runtime_error&) {
+    caught = scope_guard::detail::uncaught_exceptions() == 0;
+  }
+  switch_fiber(*unwinding_fiber, *main_fiber);
+}
+
+void run_guard_fiber() {
+  {
+    SCOPE_FAIL{ ++fail_count; };
+    SCOPE_SUCCESS{ ++success_count; };
+    switch_fiber(*guard_fiber, *unwinding_fiber);
+  }
+  switch_fiber(*guard_fiber, *unwinding_fiber);
+}
+
+} // namespace
+
+TEST_CASE("scope_fail and scope_success on a fiber resumed while another fiber unwinds") {
+  fiber main;
+  fiber unwinding{&run_unwinding_fiber};
+  fiber guard{&run_guard_fiber};
+  main_fiber = &main;
+  unwinding_fiber = &unwinding;
+  guard_fiber = &guard;
+
+  switch_fiber(main, guard);
+
+  REQUIRE(fail_count == 0);
+  REQUIRE(success_count == 1);
+  REQUIRE(caught);
+  REQUIRE(scope_guard::detail::uncaught_exceptions() == 0);
+}
+
+namespace {
+
+fiber* handler_fiber = nullptr;
+fiber* other_fiber = nullptr;
+
+bool other_saw_exception = true;
+bool rethrown = false;
+
+void run_handler_fiber() {
+  try {
+    throw std::logic_error{"handled"};
+  } catch (const std::logic_error&) {
+    switch_fiber(*handler_fiber, *other_fiber);
+    try {
+      throw;
+    } catch (const std::logic_error&) {
+      rethrown = true;
+    }
+  }
+  switch_fiber(*handler_fiber, *main_fiber);
+}
+
+void run_other_fiber() {
+  other_saw_exception = std::current_exception() != nullptr;
+  try {
+    throw 1;
+  } catch (int) {}
+  switch_fiber(*other_fiber, *handler_fiber);
+}
+
+} // namespace
+
+TEST_CASE("caught exceptions follow the fiber") {
+  fiber main;
+  fiber handler{&run_handler_fiber};
+  fiber other{&run_other_fiber};
+  main_fiber = &main;
+  handler_fiber = &handler;
+  other_fiber = &other;
+
+  switch_fiber(main, handler);
+
+  REQUIRE_FALSE(other_saw_exception);
+  REQUIRE(rethrown);
+  REQUIRE(std::current_exception() == nullptr);
+}
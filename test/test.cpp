@@ -26,10 +26,28 @@
 #define SCOPE_GUARD_NO_THROW_CONSTRUCTIBLE
 #include <scope_guard.hpp>
 
+#include <cstddef>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 
+static bool fail_nothrow_new = false;
+
+// Lets the scope_stack tests fail the allocation of a spill chunk.
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  if (fail_nothrow_new) {
+    return nullptr;
+  }
+  try {
+    return ::operator new(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
 struct ExecutionCounter {
   void Execute() {
     ++count;
@@ -74,6 +92,121 @@ static_assert(!scope_guard::detail::is_noarg_returns_void_action<ReturnsInt&>::v
 static_assert(std::is_nothrow_destructible<decltype(scope_guard::make_scope_exit(LvalueNoexceptRvalueThrow{}))>::value,
               "scope_guard should compute noexcept from the stored lvalue action.");
 
+struct EmptyAction {
+  void operator() () {}
+};
+
+struct NoThrowEmptyAction {
+  void operator() () noexcept {}
+};
+
+struct ReferenceAction {
+  int* count;
+
+  void operator() () {
+    ++*count;
+  }
+};
+
+struct TailPaddedAction {
+  TailPaddedAction() = default;
+
+  int* count;
+  char tag;
+
+  void operator() () {}
+};
+
+struct FinalEmptyAction final {
+  void operator() () {}
+};
+
+static_assert(sizeof(scope_guard::detail::scope_defer<ReferenceAction>) == sizeof(ReferenceAction),
+              "non-dismissible guard should occupy exactly sizeof(action).");
+static_assert(sizeof(scope_guard::detail::scope_defer<EmptyAction>) == 1,
+              "non-dismissible guard with an empty action should occupy one byte.");
+static_assert(sizeof(scope_guard::detail::scope_exit<EmptyAction>) == sizeof(bool),
+              "scope_exit with an empty action should occupy only its flag.");
+static_assert(sizeof(scope_guard::detail::scope_fail<EmptyAction>) == sizeof(int),
+              "scope_fail with an empty action should occupy only its exception baseline.");
+static_assert(sizeof(scope_guard::detail::scope_success<EmptyAction>) == sizeof(int),
+              "scope_success with an empty action should occupy only its exception baseline.");
+#if __cplusplus >= 202002L && !defined(_MSC_VER)
+static_assert(sizeof(scope_guard::detail::scope_exit<FinalEmptyAction>) == sizeof(bool),
+              "final empty action should be a [[no_unique_address]] member.");
+#else
+static_assert(sizeof(scope_guard::detail::scope_exit<FinalEmptyAction>) == 2,
+              "final empty action can not be an empty base.");
+#endif
+static_assert(sizeof(scope_guard::detail::scope_exit<ReferenceAction>) == 2 * sizeof(void*),
+              "scope_exit with a pointer-sized action should occupy two pointers.");
+static_assert(sizeof(scope_guard::detail::scope_fail<ReferenceAction>) == 2 * sizeof(void*),
+              "scope_fail with a pointer-sized action should occupy two pointers.");
+static_assert(sizeof(scope_guard::detail::scope_exit<void (*)()>) == 2 * sizeof(void*),
+              "scope_exit with a function pointer should occupy two pointers.");
+#if __cplusplus >= 202002L && !defined(_MSC_VER)
+static_assert(sizeof(scope_guard::detail::scope_exit<TailPaddedAction>) == sizeof(TailPaddedAction),
+              "scope_exit flag should be placed in the tail padding of the action.");
+static_assert(sizeof(scope_guard::detail::scope_fail<TailPaddedAction>) == sizeof(TailPaddedAction),
+              "scope_fail exception baseline should be placed in the tail padding of the action.");
+#endif
+static_assert(!std::is_move_constructible<scope_guard::detail::scope_defer<ReferenceAction>>::value,
+              "non-dismissible guard should not be movable.");
+static_assert(std::is_move_constructible<scope_guard::detail::scope_exit<ReferenceAction>>::value,
+              "dismissible guard should be movable.");
+static_assert(std::is_same<decltype(scope_guard::detail::scope_defer_tag{} << EmptyAction{}), scope_guard::detail::scope_defer<EmptyAction>>::value,
+              "SCOPE_EXIT should create a non-dismissible guard.");
+
+struct ExpectedLike {
+  bool ok;
+
+  bool has_value() const noexcept {
+    return ok;
+  }
+};
+
+struct CancellationToken {
+  bool cancelled;
+};
+
+// Runs the action only if the bound token was cancelled, does not touch the exception runtime.
+class OnCancelPolicy {
+  const CancellationToken* token_;
+
+ public:
+  explicit OnCancelPolicy(const CancellationToken& token) noexcept : token_{&token} {}
+
+  void dismiss() noexcept {
+    token_ = nullptr;
+  }
+
+  bool should_execute() const noexcept {
+    return token_ != nullptr && token_->cancelled;
+  }
+};
+
+// Empty non-dismissible policy.
+struct AlwaysPolicy {
+  explicit AlwaysPolicy(bool) noexcept {}
+
+  bool should_execute() const noexcept {
+    return true;
+  }
+};
+
+struct NoShouldExecutePolicy {
+  explicit NoShouldExecutePolicy(bool) noexcept {}
+};
+
+static_assert(scope_guard::is_scope_guard_policy<OnCancelPolicy>::value, "OnCancelPolicy must satisfy the policy requirements.");
+static_assert(scope_guard::is_scope_guard_policy<AlwaysPolicy>::value, "AlwaysPolicy must satisfy the policy requirements.");
+static_assert(!scope_guard::is_scope_guard_policy<NoShouldExecutePolicy>::value, "policy without should_execute must be rejected.");
+static_assert(!scope_guard::is_scope_guard_policy<bool>::value, "non-class policy must be rejected.");
+static_assert(sizeof(scope_guard::detail::scope_guard<ReferenceAction, AlwaysPolicy>) == sizeof(ReferenceAction),
+              "empty user policy should add no storage.");
+static_assert(sizeof(scope_guard::detail::scope_guard<ReferenceAction, OnCancelPolicy>) == 2 * sizeof(void*),
+              "user policy should be stored next to the action.");
+
 int with_scope_return_count = 0;
 int function_pointer_count = 0;
 
@@ -166,6 +299,45 @@ TEST_CASE("factory functions create guards") {
   }
 }
 
+TEST_CASE("guard size for common capture shapes") {
+  int a = 0;
+  int b = 0;
+  auto no_capture = []() {};
+  auto one_reference = [&a]() { ++a; };
+  auto two_references = [&a, &b]() { ++a; ++b; };
+  (void)no_capture;
+  (void)one_reference;
+  (void)two_references;
+
+  static_assert(sizeof(scope_guard::detail::scope_defer<decltype(no_capture)>) == 1, "");
+  static_assert(sizeof(scope_guard::detail::scope_exit<decltype(no_capture)>) == sizeof(bool), "");
+  static_assert(sizeof(scope_guard::detail::scope_fail<decltype(no_capture)>) == sizeof(int), "");
+  static_assert(sizeof(scope_guard::detail::scope_defer<decltype(one_reference)>) == sizeof(void*), "");
+  static_assert(sizeof(scope_guard::detail::scope_exit<decltype(one_reference)>) == 2 * sizeof(void*), "");
+  static_assert(sizeof(scope_guard::detail::scope_fail<decltype(one_reference)>) == 2 * sizeof(void*), "");
+  static_assert(sizeof(scope_guard::detail::scope_defer<decltype(two_references)>) == 2 * sizeof(void*), "");
+  static_assert(sizeof(scope_guard::detail::scope_exit<decltype(two_references)>) == 3 * sizeof(void*), "");
+  static_assert(sizeof(scope_guard::detail::scope_fail<decltype(two_references)>) == 3 * sizeof(void*), "");
+
+  REQUIRE_NOTHROW([&]() {
+    auto sg1 = scope_guard::make_scope_exit(std::move(one_reference));
+    auto sg2 = scope_guard::make_scope_exit(std::move(no_capture));
+  }());
+  REQUIRE(a == 1);
+}
+
+TEST_CASE("non-dismissible guard executes once") {
+  int count = 0;
+
+  REQUIRE_NOTHROW([&]() {
+    const auto& sg = scope_guard::detail::scope_defer_tag{} << ReferenceAction{&count};
+    (void)sg;
+    REQUIRE(count == 0);
+  }());
+
+  REQUIRE(count == 1);
+}
+
 TEST_CASE("move transfers execution ownership") {
   int count = 0;
 
@@ -501,3 +673,836 @@ TEST_CASE("nested scope_success fires only when no exception") {
   REQUIRE(inner_count == 0);
   REQUIRE(outer_count == 1);
 }
+
+TEST_CASE("scope_fail_region shares the exception baseline") {
+  SUBCASE("normal leave") {
+    int fail_count = 0;
+    int success_count = 0;
+
+    REQUIRE_NOTHROW([&]() {
+      scope_guard::scope_fail_region region;
+      SCOPE_FAIL_IN(region){ ++fail_count; };
+      SCOPE_FAIL_IN(region){ ++fail_count; };
+      SCOPE_SUCCESS_IN(region){ ++success_count; };
+      auto sg = scope_guard::make_scope_success(region, [&]() { ++success_count; });
+      REQUIRE_FALSE(region.failed());
+    }());
+    REQUIRE(fail_count == 0);
+    REQUIRE(success_count == 2);
+  }
+
+  SUBCASE("exception") {
+    int fail_count = 0;
+    int success_count = 0;
+
+    REQUIRE_THROWS([&]() {
+      scope_guard::scope_fail_region region;
+      SCOPE_FAIL_IN(region){ ++fail_count; };
+      auto sg = scope_guard::make_scope_fail(region, [&]() { ++fail_count; });
+      SCOPE_SUCCESS_IN(region){ ++success_count; };
+
+      throw std::exception{};
+    }());
+    REQUIRE(fail_count == 2);
+    REQUIRE(success_count == 0);
+  }
+
+  SUBCASE("dismiss") {
+    int fail_count = 0;
+
+    REQUIRE_THROWS([&]() {
+      scope_guard::scope_fail_region region;
+      MAKE_SCOPE_FAIL_IN(sg1, region){ ++fail_count; };
+      MAKE_SCOPE_FAIL_IN(sg2, region){ ++fail_count; };
+      sg1.dismiss();
+
+      throw std::exception{};
+    }());
+    REQUIRE(fail_count == 1);
+  }
+
+  SUBCASE("region inside catch of caught exception") {
+    int outer_count = 0;
+    int inner_count = 0;
+
+    REQUIRE_NOTHROW([&]() {
+      scope_guard::scope_fail_region outer;
+      SCOPE_FAIL_IN(outer){ ++outer_count; };
+
+      try {
+        scope_guard::scope_fail_region inner;
+        SCOPE_FAIL_IN(inner){ ++inner_count; };
+        throw std::runtime_error{"inner"};
+      } catch (...) {
+        // caught, not rethrown
+      }
+    }());
+    REQUIRE(inner_count == 1);
+    REQUIRE(outer_count == 0);
+  }
+
+  SUBCASE("exception caught inside the region") {
+    int rolled = 0;
+    int caught = 0;
+
+    REQUIRE_NOTHROW([&]() {
+      scope_guard::scope_fail_region region;
+      SCOPE_FAIL_IN(region){ ++rolled; };
+      try {
+        SCOPE_FAIL_IN(region){ ++caught; };
+        throw std::runtime_error{"caught"};
+      } catch (...) {
+        // caught, not rethrown
+      }
+      SCOPE_FAIL_IN(region){ ++rolled; };
+    }());
+    REQUIRE(caught == 1);
+    REQUIRE(rolled == 0);
+  }
+}
+
+TEST_CASE("scope_fail_on/scope_success_on decide from a status") {
+  SUBCASE("bool success flag") {
+    int fail_count = 0;
+    int success_count = 0;
+
+    [&]() {
+      bool ok = false;
+      SCOPE_FAIL_ON(ok){ ++fail_count; };
+      SCOPE_SUCCESS_ON(ok){ ++success_count; };
+    }();
+    REQUIRE(fail_count == 1);
+    REQUIRE(success_count == 0);
+
+    [&]() {
+      bool ok = false;
+      auto sg1 = scope_guard::make_scope_fail_on(ok, [&]() { ++fail_count; });
+      auto sg2 = scope_guard::make_scope_success_on(ok, [&]() { ++success_count; });
+      ok = true;
+    }();
+    REQUIRE(fail_count == 1);
+    REQUIRE(success_count == 1);
+  }
+
+  SUBCASE("error_code") {
+    int fail_count = 0;
+
+    [&]() {
+      std::error_code ec;
+      SCOPE_FAIL_ON(ec){ ++fail_count; };
+    }();
+    REQUIRE(fail_count == 0);
+
+    [&]() {
+      std::error_code ec;
+      SCOPE_FAIL_ON(ec){ ++fail_count; };
+      ec = std::make_error_code(std::errc::invalid_argument);
+    }();
+    REQUIRE(fail_count == 1);
+  }
+
+  SUBCASE("expected-like result") {
+    int fail_count = 0;
+    int success_count = 0;
+
+    [&]() {
+      ExpectedLike result{false};
+      SCOPE_FAIL_ON(result){ ++fail_count; };
+      SCOPE_SUCCESS_ON(result){ ++success_count; };
+      result = ExpectedLike{true};
+    }();
+    REQUIRE(fail_count == 0);
+    REQUIRE(success_count == 1);
+  }
+
+  SUBCASE("dismiss") {
+    int fail_count = 0;
+
+    [&]() {
+      bool ok = false;
+      MAKE_SCOPE_FAIL_ON(sg, ok){ ++fail_count; };
+      sg.dismiss();
+    }();
+    REQUIRE(fail_count == 0);
+  }
+
+  SUBCASE("exception does not affect the decision") {
+    int fail_count = 0;
+    int success_count = 0;
+
+    REQUIRE_THROWS([&]() {
+      bool ok = true;
+      SCOPE_FAIL_ON(ok){ ++fail_count; };
+      SCOPE_SUCCESS_ON(ok){ ++success_count; };
+      throw std::exception{};
+    }());
+    REQUIRE(fail_count == 0);
+    REQUIRE(success_count == 1);
+  }
+}
+
+TEST_CASE("scope_transaction") {
+  int rollbacks = 0;
+
+  SUBCASE("commit dismisses every rollback") {
+    {
+      scope_guard::scope_transaction transaction;
+      SCOPE_ROLLBACK(transaction){ ++rollbacks; };
+      MAKE_SCOPE_ROLLBACK(named, transaction){ ++rollbacks; };
+      auto made = scope_guard::make_scope_rollback(transaction, [&]() { ++rollbacks; });
+      transaction.commit();
+    }
+    REQUIRE(rollbacks == 0);
+  }
+
+  SUBCASE("rollbacks execute without commit") {
+    {
+      scope_guard::scope_transaction transaction;
+      SCOPE_ROLLBACK(transaction){ rollbacks = rollbacks * 10 + 1; };
+      auto made = scope_guard::make_scope_rollback(transaction, [&]() { rollbacks = rollbacks * 10 + 2; });
+    }
+    REQUIRE(rollbacks == 21);
+
+    rollbacks = 0;
+    REQUIRE_THROWS_AS([&]() {
+      scope_guard::scope_transaction transaction;
+      SCOPE_ROLLBACK(transaction){ ++rollbacks; };
+      throw std::runtime_error{"error"};
+    }(), std::runtime_error);
+    REQUIRE(rollbacks == 1);
+  }
+
+  SUBCASE("dismiss one rollback") {
+    {
+      scope_guard::scope_transaction transaction;
+      MAKE_SCOPE_ROLLBACK(first, transaction){ rollbacks += 1; };
+      MAKE_SCOPE_ROLLBACK(second, transaction){ rollbacks += 10; };
+      first.dismiss();
+    }
+    REQUIRE(rollbacks == 10);
+  }
+}
+
+TEST_CASE("per-guard throw policy") {
+  SUBCASE("suppress_throw_action") {
+    int count = 0;
+
+    REQUIRE_NOTHROW([&]() {
+      auto guard = scope_guard::make_scope_exit<scope_guard::suppress_throw_action>([&]() {
+        ++count;
+        throw std::runtime_error{"cleanup failure"};
+      });
+    }());
+    REQUIRE(count == 1);
+  }
+
+  SUBCASE("no_throw_action") {
+    int count = 0;
+    static_assert(std::is_nothrow_destructible<decltype(scope_guard::make_scope_exit<scope_guard::no_throw_action>(NoThrowEmptyAction{}))>::value,
+                  "no_throw_action guard must have a noexcept destructor.");
+
+    {
+      auto guard = scope_guard::make_scope_fail<scope_guard::no_throw_action>([&]() noexcept { ++count; });
+    }
+    REQUIRE(count == 0);
+    {
+      auto guard = scope_guard::make_scope_success<scope_guard::no_throw_action>([&]() noexcept { ++count; });
+    }
+    REQUIRE(count == 1);
+  }
+
+  SUBCASE("default policy still propagates") {
+    REQUIRE_THROWS_AS([&]() {
+      auto guard = scope_guard::make_scope_exit([]() { throw std::runtime_error{"cleanup failure"}; });
+    }(), std::runtime_error);
+  }
+}
+
+TEST_CASE("user-defined policy") {
+  SUBCASE("policy object") {
+    int count = 0;
+    CancellationToken token{false};
+
+    {
+      auto guard = scope_guard::make_scope_guard(OnCancelPolicy{token}, [&]() { ++count; });
+    }
+    REQUIRE(count == 0);
+
+    {
+      auto guard = scope_guard::make_scope_guard(OnCancelPolicy{token}, [&]() { ++count; });
+      token.cancelled = true;
+    }
+    REQUIRE(count == 1);
+
+    {
+      auto guard = scope_guard::make_scope_guard(OnCancelPolicy{token}, [&]() { ++count; });
+      guard.dismiss();
+    }
+    REQUIRE(count == 1);
+  }
+
+  SUBCASE("move") {
+    int count = 0;
+    CancellationToken token{true};
+
+    {
+      auto guard = scope_guard::make_scope_guard(OnCancelPolicy{token}, [&]() { ++count; });
+      auto moved = std::move(guard);
+    }
+    REQUIRE(count == 1);
+  }
+
+  SUBCASE("policy constructed from bool") {
+    int count = 0;
+
+    {
+      const auto& guard = scope_guard::make_scope_guard<AlwaysPolicy>([&]() { ++count; });
+      static_cast<void>(guard);
+    }
+    REQUIRE(count == 1);
+  }
+
+  SUBCASE("per-guard throw policy") {
+    int count = 0;
+    CancellationToken token{true};
+
+    REQUIRE_NOTHROW([&]() {
+      auto guard = scope_guard::make_scope_guard<scope_guard::suppress_throw_action>(OnCancelPolicy{token}, [&]() {
+        ++count;
+        throw std::runtime_error{"cleanup failure"};
+      });
+    }());
+    REQUIRE(count == 1);
+  }
+}
+
+struct CountedAction {
+  int* order;
+  int* destroyed;
+  int id;
+
+  CountedAction(int* o, int* d, int i) noexcept : order{o}, destroyed{d}, id{i} {}
+
+  CountedAction(CountedAction&& other) noexcept : order{other.order}, destroyed{other.destroyed}, id{other.id} {
+    other.destroyed = nullptr;
+  }
+
+  ~CountedAction() {
+    if (destroyed != nullptr) {
+      ++*destroyed;
+    }
+  }
+
+  void operator() () {
+    *order = *order * 10 + id;
+  }
+};
+
+struct LargeAction {
+  int* count;
+  char padding[40];
+
+  void operator() () {
+    ++*count;
+  }
+};
+
+static_assert(sizeof(scope_guard::make_scope_exit(std::declval<ReferenceAction>(), std::declval<ReferenceAction>(), std::declval<ReferenceAction>())) == 3 * sizeof(ReferenceAction) + alignof(ReferenceAction),
+              "scope_exit group should hold one policy for all actions.");
+static_assert(sizeof(scope_guard::make_scope_fail(EmptyAction{}, EmptyAction{})) == sizeof(int),
+              "scope_fail group of empty actions should hold only the exception baseline.");
+
+TEST_CASE("scope_group") {
+  int order = 0;
+
+  SUBCASE("actions run in reverse order") {
+    {
+      auto guard = scope_guard::make_scope_exit([&]() { order = order * 10 + 1; }, [&]() { order = order * 10 + 2; }, [&]() { order = order * 10 + 3; });
+    }
+    REQUIRE(order == 321);
+  }
+
+  SUBCASE("dismiss disables every action") {
+    {
+      auto guard = scope_guard::make_scope_exit([&]() { order = order * 10 + 1; }, [&]() { order = order * 10 + 2; });
+      guard.dismiss();
+    }
+    REQUIRE(order == 0);
+  }
+
+  SUBCASE("fail and success groups") {
+    int fail = 0;
+    int success = 0;
+    REQUIRE_THROWS_AS([&]() {
+      auto on_fail = scope_guard::make_scope_fail([&]() { fail += 1; }, [&]() { fail += 10; });
+      auto on_success = scope_guard::make_scope_success([&]() { success += 1; }, [&]() { success += 10; });
+      throw std::runtime_error{"error"};
+    }(), std::runtime_error);
+    REQUIRE(fail == 11);
+    REQUIRE(success == 0);
+
+    [&]() {
+      auto on_fail = scope_guard::make_scope_fail([&]() { fail += 1; }, [&]() { fail += 10; });
+      auto on_success = scope_guard::make_scope_success([&]() { success += 1; }, [&]() { success += 10; });
+    }();
+    REQUIRE(fail == 11);
+    REQUIRE(success == 11);
+  }
+
+  SUBCASE("remaining actions run if an action throws") {
+    REQUIRE_THROWS_AS([&]() {
+      auto guard = scope_guard::make_scope_exit([&]() { order = order * 10 + 1; }, [&]() { throw std::runtime_error{"error"}; }, [&]() { order = order * 10 + 3; });
+    }(), std::runtime_error);
+    REQUIRE(order == 31);
+  }
+
+  SUBCASE("last action throws") {
+    REQUIRE_THROWS_AS([&]() {
+      auto guard = scope_guard::make_scope_exit([&]() { order = order * 10 + 1; }, [&]() { order = order * 10 + 2; }, [&]() { throw std::runtime_error{"error"}; });
+    }(), std::runtime_error);
+    REQUIRE(order == 21);
+  }
+
+  SUBCASE("suppress_throw_action per action") {
+    {
+      auto guard = scope_guard::make_scope_exit<scope_guard::suppress_throw_action>([&]() { order = order * 10 + 1; }, [&]() { throw std::runtime_error{"error"}; }, [&]() { order = order * 10 + 3; });
+      static_assert(noexcept(guard.~scope_guard()), "suppress_throw_action group should be noexcept.");
+    }
+    REQUIRE(order == 31);
+  }
+
+  SUBCASE("move transfers the whole group") {
+    {
+      auto guard = scope_guard::make_scope_exit([&]() { order = order * 10 + 1; }, [&]() { order = order * 10 + 2; });
+      auto moved = std::move(guard);
+      REQUIRE(order == 0);
+    }
+    REQUIRE(order == 21);
+  }
+}
+
+TEST_CASE("scope_stack") {
+  SUBCASE("runs actions in reverse order") {
+    int order = 0;
+    int destroyed = 0;
+
+    {
+      scope_guard::scope_exit_stack<> stack;
+      for (int i = 1; i <= 3; ++i) {
+        stack.push(CountedAction{&order, &destroyed, i});
+      }
+      REQUIRE(stack.size() == 3);
+    }
+    REQUIRE(order == 321);
+    REQUIRE(destroyed == 3);
+  }
+
+  SUBCASE("spills out of the inline buffer") {
+    int sum = 0;
+    int count = 0;
+
+    {
+      scope_guard::scope_exit_stack<32> stack;
+      for (int i = 0; i < 1000; ++i) {
+        if (i % 3 == 0) {
+          stack.push([&sum, i]() { sum += i; });
+        } else {
+          stack.push(LargeAction{&count, {}});
+        }
+      }
+      REQUIRE(stack.size() == 1000);
+    }
+    REQUIRE(sum == 166833);
+    REQUIRE(count == 666);
+  }
+
+  SUBCASE("fail and success") {
+    int fail_count = 0;
+    int success_count = 0;
+
+    [&]() {
+      scope_guard::scope_fail_stack<> fail_stack;
+      scope_guard::scope_success_stack<> success_stack;
+      fail_stack.push([&]() { ++fail_count; });
+      success_stack.push([&]() { ++success_count; });
+    }();
+    REQUIRE(fail_count == 0);
+    REQUIRE(success_count == 1);
+
+    REQUIRE_THROWS([&]() {
+      scope_guard::scope_fail_stack<> fail_stack;
+      scope_guard::scope_success_stack<> success_stack;
+      fail_stack.push([&]() { ++fail_count; });
+      success_stack.push([&]() { ++success_count; });
+      throw std::exception{};
+    }());
+    REQUIRE(fail_count == 1);
+    REQUIRE(success_count == 1);
+  }
+
+  SUBCASE("dismiss_all") {
+    int order = 0;
+    int destroyed = 0;
+
+    {
+      scope_guard::scope_exit_stack<64> stack;
+      for (int i = 1; i <= 5; ++i) {
+        stack.push(CountedAction{&order, &destroyed, i});
+      }
+      stack.dismiss_all();
+      stack.push(CountedAction{&order, &destroyed, 6});
+    }
+    REQUIRE(order == 6);
+    REQUIRE(destroyed == 6);
+  }
+
+  SUBCASE("throwing action does not skip the rest") {
+    int count = 0;
+
+    REQUIRE_THROWS_AS([&]() {
+      scope_guard::scope_exit_stack<> stack;
+      stack.push([&]() { ++count; });
+      stack.push([&]() { ++count; throw std::runtime_error{"cleanup failure"}; });
+      stack.push([&]() { ++count; });
+    }(), std::runtime_error);
+    REQUIRE(count == 3);
+  }
+
+  SUBCASE("push runs the action and throws if a chunk can not be allocated") {
+    int exit_count = 0;
+    int success_count = 0;
+    int count = 0;
+
+    {
+      scope_guard::scope_exit_stack<64> exit_stack;
+      scope_guard::scope_success_stack<64> success_stack;
+      exit_stack.push(LargeAction{&count, {}});
+      success_stack.push(LargeAction{&count, {}});
+      fail_nothrow_new = true;
+      REQUIRE_THROWS_AS(exit_stack.push(LargeAction{&exit_count, {}}), std::bad_alloc);
+      REQUIRE_THROWS_AS(success_stack.push(LargeAction{&success_count, {}}), std::bad_alloc);
+      fail_nothrow_new = false;
+      REQUIRE(exit_count == 1);
+      REQUIRE(success_count == 0);
+      REQUIRE(exit_stack.size() == 1);
+      REQUIRE(success_stack.size() == 1);
+    }
+    REQUIRE(count == 2);
+    REQUIRE(exit_count == 1);
+    REQUIRE(success_count == 0);
+  }
+
+  SUBCASE("try_push leaves the action to the caller if a chunk can not be allocated") {
+    int count = 0;
+
+    {
+      scope_guard::scope_exit_stack<64> stack;
+      REQUIRE(stack.try_push(LargeAction{&count, {}}));
+      LargeAction action{&count, {}};
+      fail_nothrow_new = true;
+      const bool pushed = stack.try_push(std::move(action));
+      fail_nothrow_new = false;
+      REQUIRE_FALSE(pushed);
+      REQUIRE(count == 0);
+      REQUIRE(stack.size() == 1);
+      action();
+      REQUIRE(count == 1);
+    }
+    REQUIRE(count == 2);
+  }
+}
+
+struct Connection {
+  scope_guard::any_scope_exit<> on_close;
+};
+
+static_assert(std::is_move_constructible<scope_guard::any_scope_exit<>>::value, "any_scope_exit should be movable.");
+static_assert(std::is_default_constructible<scope_guard::any_scope_exit<>>::value, "any_scope_exit should be default constructible.");
+static_assert(!std::is_copy_constructible<scope_guard::any_scope_exit<>>::value, "any_scope_exit should not be copyable.");
+
+TEST_CASE("any_scope") {
+  SUBCASE("member") {
+    int count = 0;
+
+    {
+      Connection connection;
+      REQUIRE_FALSE(connection.on_close);
+      connection.on_close = scope_guard::any_scope_exit<>{[&count]() { ++count; }};
+      REQUIRE(connection.on_close);
+    }
+    REQUIRE(count == 1);
+  }
+
+  SUBCASE("move transfers the action") {
+    int order = 0;
+    int destroyed = 0;
+
+    {
+      scope_guard::any_scope_exit<sizeof(CountedAction)> a{CountedAction{&order, &destroyed, 1}};
+      scope_guard::any_scope_exit<sizeof(CountedAction)> b{std::move(a)};
+      REQUIRE_FALSE(a);
+      REQUIRE(b);
+    }
+    REQUIRE(order == 1);
+    REQUIRE(destroyed == 1);
+  }
+
+  SUBCASE("move assignment finishes the held action") {
+    int order = 0;
+    int destroyed = 0;
+
+    {
+      scope_guard::any_scope_exit<sizeof(CountedAction)> a{CountedAction{&order, &destroyed, 1}};
+      a = scope_guard::any_scope_exit<sizeof(CountedAction)>{CountedAction{&order, &destroyed, 2}};
+      REQUIRE(order == 1);
+    }
+    REQUIRE(order == 12);
+    REQUIRE(destroyed == 2);
+  }
+
+  SUBCASE("dismiss destroys the action") {
+    int order = 0;
+    int destroyed = 0;
+
+    {
+      scope_guard::any_scope_exit<sizeof(CountedAction)> a{CountedAction{&order, &destroyed, 1}};
+      a.dismiss();
+      REQUIRE(destroyed == 1);
+    }
+    REQUIRE(order == 0);
+    REQUIRE(destroyed == 1);
+  }
+
+  SUBCASE("fail and success") {
+    int fail_count = 0;
+    int success_count = 0;
+
+    [&]() {
+      scope_guard::any_scope_fail<> fail{[&]() { ++fail_count; }};
+      scope_guard::any_scope_success<> success{[&]() { ++success_count; }};
+    }();
+    REQUIRE(fail_count == 0);
+    REQUIRE(success_count == 1);
+
+    REQUIRE_THROWS([&]() {
+      scope_guard::any_scope_fail<> fail{[&]() { ++fail_count; }};
+      scope_guard::any_scope_success<> success{[&]() { ++success_count; }};
+      throw std::exception{};
+    }());
+    REQUIRE(fail_count == 1);
+    REQUIRE(success_count == 1);
+  }
+}
+
+struct UniqueAction {
+  std::unique_ptr<int> resource;
+  int* count;
+
+  void operator() () {
+    *count += *resource;
+  }
+};
+
+struct CopyCountingAction {
+  CopyCountingAction(int* c, int* m) : count{c}, moves{m} {}
+  CopyCountingAction(CopyCountingAction&& other) noexcept : count{other.count}, moves{other.moves} { ++*moves; }
+  CopyCountingAction(const CopyCountingAction&) = delete;
+
+  int* count;
+  int* moves;
+
+  void operator() () {
+    ++*count;
+  }
+};
+
+template <>
+struct scope_guard::is_trivially_relocatable<UniqueAction> : std::true_type {};
+
+static_assert(scope_guard::is_trivially_relocatable<scope_guard::detail::scope_exit<ReferenceAction>>::value,
+              "scope_exit with a trivially copyable action should be trivially relocatable.");
+static_assert(scope_guard::is_trivially_relocatable<scope_guard::detail::scope_fail<EmptyAction>>::value,
+              "scope_fail with a trivially copyable action should be trivially relocatable.");
+static_assert(scope_guard::is_trivially_relocatable<scope_guard::detail::scope_exit<UniqueAction>>::value,
+              "scope_exit should be trivially relocatable when its action is specialized as such.");
+static_assert(!scope_guard::is_trivially_relocatable<scope_guard::detail::scope_exit<CopyCountingAction>>::value,
+              "scope_exit with a non trivially relocatable action should not be trivially relocatable.");
+#if defined(NEARGYE_SCOPE_GUARD_PINNED_GUARDS)
+static_assert(scope_guard::is_trivially_relocatable<scope_guard::pinned_scope_exit<ReferenceAction>>::value,
+              "pinned_scope_exit should be trivially relocatable, though it is not movable.");
+#endif
+
+TEST_CASE("relocate guards") {
+  using guard_type = scope_guard::detail::scope_exit<ReferenceAction>;
+  int count = 0;
+
+  SUBCASE("uninitialized_relocate") {
+    alignas(guard_type) unsigned char source[3 * sizeof(guard_type)];
+    alignas(guard_type) unsigned char destination[3 * sizeof(guard_type)];
+    guard_type* first = reinterpret_cast<guard_type*>(source);
+    guard_type* result = reinterpret_cast<guard_type*>(destination);
+    for (int i = 0; i < 3; ++i) {
+      ::new (static_cast<void*>(first + i)) guard_type{scope_guard::make_scope_exit(ReferenceAction{&count})};
+    }
+    first[1].dismiss();
+
+    guard_type* last = scope_guard::uninitialized_relocate(first, first + 3, result);
+    REQUIRE(last == result + 3);
+    REQUIRE(count == 0);
+
+    for (guard_type* it = result; it != last; ++it) {
+      it->~guard_type();
+    }
+    REQUIRE(count == 2);
+  }
+
+  SUBCASE("relocate_at with a specialized action") {
+    using unique_guard_type = scope_guard::detail::scope_exit<UniqueAction>;
+    alignas(unique_guard_type) unsigned char source[sizeof(unique_guard_type)];
+    alignas(unique_guard_type) unsigned char destination[sizeof(unique_guard_type)];
+    unique_guard_type* guard = ::new (static_cast<void*>(source)) unique_guard_type{scope_guard::make_scope_exit(UniqueAction{std::unique_ptr<int>{new int{5}}, &count})};
+
+    unique_guard_type* relocated = scope_guard::relocate_at(guard, reinterpret_cast<unique_guard_type*>(destination));
+    REQUIRE(count == 0);
+
+    relocated->~unique_guard_type();
+    REQUIRE(count == 5);
+  }
+
+  SUBCASE("relocate_at falls back to move") {
+    using counting_guard_type = scope_guard::detail::scope_exit<CopyCountingAction>;
+    int moves = 0;
+    alignas(counting_guard_type) unsigned char source[sizeof(counting_guard_type)];
+    alignas(counting_guard_type) unsigned char destination[sizeof(counting_guard_type)];
+    counting_guard_type* guard = ::new (static_cast<void*>(source)) counting_guard_type{scope_guard::make_scope_exit(CopyCountingAction{&count, &moves})};
+    const int moves_before = moves;
+
+    counting_guard_type* relocated = scope_guard::relocate_at(guard, reinterpret_cast<counting_guard_type*>(destination));
+    REQUIRE(moves == moves_before + 1);
+    REQUIRE(count == 0);
+
+    relocated->~counting_guard_type();
+    REQUIRE(count == 1);
+  }
+}
+
+#if defined(NEARGYE_SCOPE_GUARD_PINNED_GUARDS)
+static_assert(!std::is_move_constructible<scope_guard::pinned_scope_exit<ReferenceAction>>::value,
+              "pinned_scope_exit should not be movable.");
+static_assert(!std::is_move_constructible<scope_guard::pinned_scope_fail<ReferenceAction>>::value,
+              "pinned_scope_fail should not be movable.");
+static_assert(!std::is_move_constructible<scope_guard::pinned_scope_success<ReferenceAction>>::value,
+              "pinned_scope_success should not be movable.");
+static_assert(sizeof(scope_guard::pinned_scope_exit<ReferenceAction>) == sizeof(ReferenceAction),
+              "pinned_scope_exit should hold no state besides the action.");
+static_assert(sizeof(scope_guard::pinned_scope_fail<EmptyAction>) == sizeof(int),
+              "pinned_scope_fail should hold only the exception baseline.");
+
+TEST_CASE("pinned guards") {
+  int exit_count = 0;
+  int fail_count = 0;
+  int success_count = 0;
+
+  [&]() {
+    auto exit = scope_guard::make_pinned_scope_exit([&]() { ++exit_count; });
+    auto fail = scope_guard::make_pinned_scope_fail([&]() { ++fail_count; });
+    auto success = scope_guard::make_pinned_scope_success([&]() { ++success_count; });
+  }();
+  REQUIRE(exit_count == 1);
+  REQUIRE(fail_count == 0);
+  REQUIRE(success_count == 1);
+
+  REQUIRE_THROWS_AS([&]() {
+    auto exit = scope_guard::make_pinned_scope_exit([&]() { ++exit_count; });
+    auto fail = scope_guard::make_pinned_scope_fail([&]() { ++fail_count; });
+    auto success = scope_guard::make_pinned_scope_success([&]() { ++success_count; });
+    throw std::runtime_error{"error"};
+  }(), std::runtime_error);
+  REQUIRE(exit_count == 2);
+  REQUIRE(fail_count == 1);
+  REQUIRE(success_count == 1);
+}
+#endif
+
+#if defined(NEARGYE_SCOPE_GUARD_CONSTEXPR_GUARDS)
+constexpr int constexpr_scope_exit() {
+  int value = 0;
+  {
+    SCOPE_EXIT{ value += 1; };
+  }
+  {
+    auto guard = scope_guard::make_scope_exit([&]() { value += 10; });
+  }
+  {
+    MAKE_SCOPE_EXIT(guard){ value += 100; };
+    guard.dismiss();
+  }
+  {
+    DEFER{ value *= 2; };
+    value += 1000;
+  }
+  return value;
+}
+
+// No exception can be thrown during constant evaluation, so scope_fail never executes and scope_success always does.
+constexpr int constexpr_scope_fail_success() {
+  int value = 0;
+  {
+    SCOPE_FAIL{ value += 1; };
+    SCOPE_SUCCESS{ value += 10; };
+    auto fail = scope_guard::make_scope_fail([&]() { value += 100; });
+    auto success = scope_guard::make_scope_success([&]() { value += 1000; });
+  }
+  return value;
+}
+
+constexpr int constexpr_scope_fail_on(bool ok) {
+  int value = 0;
+  {
+    SCOPE_FAIL_ON(ok){ value += 1; };
+    SCOPE_SUCCESS_ON(ok){ value += 10; };
+  }
+  return value;
+}
+
+constexpr int constexpr_scope_group() {
+  int value = 0;
+  {
+    auto guard = scope_guard::make_scope_exit([&]() { value = value * 10 + 1; }, [&]() { value = value * 10 + 2; }, [&]() { value = value * 10 + 3; });
+  }
+  return value;
+}
+
+struct ConstexprTable {
+  int values[4];
+  int size;
+};
+
+// Entries appended after a failed validation are rolled back by a status guard.
+constexpr ConstexprTable constexpr_build_table() {
+  ConstexprTable table{{0, 0, 0, 0}, 0};
+  for (int i = 1; i <= 4; ++i) {
+    bool valid = false;
+    const int previous = table.size;
+    SCOPE_FAIL_ON(valid){ table.size = previous; };
+    table.values[table.size++] = i * i;
+    valid = i != 3;
+  }
+  return table;
+}
+
+static_assert(constexpr_scope_exit() == 2022, "scope_exit should execute in constant evaluation.");
+static_assert(constexpr_scope_fail_success() == 1010, "scope_success should execute and scope_fail should not in constant evaluation.");
+static_assert(constexpr_scope_group() == 321, "scope_group should execute in reverse order in constant evaluation.");
+static_assert(constexpr_scope_fail_on(true) == 10, "scope_success_on should execute in constant evaluation.");
+static_assert(constexpr_scope_fail_on(false) == 1, "scope_fail_on should execute in constant evaluation.");
+static_assert(constexpr_build_table().size == 3 && constexpr_build_table().values[2] == 16, "scope_fail_on should roll back in constant evaluation.");
+
+TEST_CASE("constexpr guards") {
+  REQUIRE(constexpr_scope_exit() == 2022);
+  REQUIRE(constexpr_scope_fail_success() == 1010);
+  REQUIRE(constexpr_scope_fail_on(true) == 10);
+  REQUIRE(constexpr_scope_fail_on(false) == 1);
+  REQUIRE(constexpr_build_table().size == 3);
+}
+#endif